@@ -0,0 +1,34 @@
+// Word Hunt Solver (for GamePigeon iMessage Word Hunt Game)
+// Counting allocator for measurements: replaces the global operator new and
+// operator delete so g_allocation_count is the number of heap allocations
+// the whole program has made so far. Used by --bench in builds with
+// -DWHS_COUNT_ALLOCATIONS and by tests/warm_solve_allocations.cpp
+// NOTES: Defines the replacement operators, so include it in one
+// translation unit of a program only. Normal solver builds leave it out and
+// keep the standard allocator
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+std::atomic<uint64_t> g_allocation_count{ 0 };
+
+// (kept out of line so GCC does not pair the inlined free with new)
+#if defined(__GNUC__)
+#define WHS_NOINLINE __attribute__((noinline))
+#else
+#define WHS_NOINLINE
+#endif
+WHS_NOINLINE void* operator new(std::size_t size) {
+	g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+	throw std::bad_alloc();
+}
+WHS_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+WHS_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#endif // ALLOCATION_COUNTER_H
@@ -1,943 +1,1225 @@
-// Word Hunt Solver (for GamePigeon iMessage Word Hunt Game)
-
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <cassert>
-#include <vector>
-#include <cctype>
-#include <getopt.h>
-#include <queue>
-
-using namespace std;
-
-// Exception classes
-class File_Not_Open{ /*...*/ };
-
-// Option enumerated classes
-enum class Cardinal_Output_Mode { kNone = 0, k_Cardinal_Mode_On, };					 // -c
-enum class Index_Output_Mode { kNone = 0, k_Index_Mode_On, };						 // -i
-enum class Point_Output_Mode { kNone = 0, k_Point_Mode_On, };						 // -p
-enum class Alpha_Output_Mode { kNone = 0, k_Alpha_Mode_On, };					     // -a
-enum class Search_Depth_Output_Mode { kNone = 0, k_Search_Depth_Mode_On, };			 // -s
-enum class Board_Mode { kNone = 0, k_Board_Mode_On, };								 // -b
-enum class Linear_Search_Only_Mode { kNone = 0, k_Linear_Search_Mode_On, };			 // -l
-enum class Word_Hunt_Mode { kNone = 0, k_Word_Hunt_Mode_On, };						 // -w
-enum class Specify_Length_Mode { kNone = 0, k_Specify_Length_Mode_on, };			 // -x
-enum class Specify_First_Letter_Mode { kNone = 0, k_Specify_First_Letter_Mode_On, }; // -y
-
-
-// Options struct
-struct Options {
-	Cardinal_Output_Mode cardinal_output_mode = Cardinal_Output_Mode::kNone;
-	Index_Output_Mode index_output_mode = Index_Output_Mode::kNone;
-	Point_Output_Mode point_output_mode = Point_Output_Mode::kNone;
-	Alpha_Output_Mode alpha_output_mode = Alpha_Output_Mode::kNone;
-	Search_Depth_Output_Mode search_depth_output_mode = Search_Depth_Output_Mode::kNone;
-	Board_Mode board_mode = Board_Mode::kNone;
-	Linear_Search_Only_Mode linear_mode = Linear_Search_Only_Mode::kNone;
-	Word_Hunt_Mode word_hunt_mode = Word_Hunt_Mode::kNone;
-	Specify_Length_Mode specify_length_mode = Specify_Length_Mode::kNone;
-	Specify_First_Letter_Mode specify_first_letter_mode = Specify_First_Letter_Mode::kNone;
-
-	int search_depth = 6;					// Default Search Depth value is 6
-	string board_filename = "board.txt";	// Default Board filename is "board.txt"
-	int specified_length = 0;
-	vector<char> specified_first_letters;
-};
-
-
-// Word Hunt Solver Class
-class Word_Hunt_Solver {
-private:
-	vector<vector<char>> board;
-	vector<string> list_of_words;
-	int width = 0;
-	int height = 0;
-	bool cardinal_on = false;
-	bool index_on = false;
-	bool point_on = false;
-	bool alpha_on = false;
-	bool search_depth_on = false;
-	bool board_on = false;
-	bool linear_on = false;
-	int search_depth = 6;				// Default Search Depth value is 6
-	string board_filename = "board.txt";// Default Board filename is "board.txt"
-	bool specifed_length_on = false;
-	bool specifed_first_letter_on = false;
-	int specified_length = 0;
-	vector<char> specified_first_letters;
-	bool word_hunt_mode_on = false;
-
-	// Coordinate Compare Functor
-	class Coordinate_Compare {
-	public:
-		// EFFECTS: Returns true if a's priority < b's priority
-		bool operator()(const pair<int, int>& a, const pair<int, int>& b) {
-			if (a.first < b.first) return true;
-			else if (a.first > b.first) return false;
-			else {
-				if (a.second < b.second) return true;
-				return false;
-			}
-		}
-	};
-
-
-
-	// Found Word struct
-	struct Found_Word {
-		string word = "";
-		vector<char> cardinal_directions;
-		vector<int> index_directions;
-		unsigned int length = 0;
-		pair<int, int> coordinates;
-		//priority_queue<pair<int, int>, vector<pair<int, int>>, Coordinate_Compare> c_pq; // Coordinate Priority Queue
-		vector<pair<int, int>> coordinate_vect;
-		bool word_hunt_valid = false;
-	};
-
-	vector<Found_Word> found_word_vect;
-
-	// String_Compare Functor
-	class String_Compare {
-	public:
-		// EFFECTS: Returns true if a is alphabetically more than b
-		// Returns false otherwise
-		// NOTES: Just for clarification: words that start with 'A' will be 
-		// prioritized more than words that start with 'B', since 'A' comes first
-		// in the alphabet
-		bool operator()(const string& a, const string& b) {
-			return a > b;
-		}
-	};
-
-	// Point_Compare Functor
-	class Point_Compare {
-	public:
-		// EFFECTS: Returns true if points(a) < points(b)
-		// False otherwise
-		bool operator()(const Found_Word& a, const Found_Word& b){
-			// Note: Length = points
-			if (b.length > a.length) return true;
-			else if (b.length < a.length) return false;
-			else {
-				// If a's and b's lenght is equal, than just compare
-				// which string comes first alphabettically
-				String_Compare c;
-				return c(a.word, b.word);
-			}
-		}
-	};
-
-	// Name_Compare Functor
-	class Name_Compare {
-	public:
-		// EFFECTS: Returns true if word a < word b (alphabetically)
-		bool operator()(const Found_Word& a, const Found_Word& b) {
-			String_Compare c;
-			return c(a.word, b.word);
-		}
-	};
-
-	priority_queue<Found_Word, vector<Found_Word>, Point_Compare> point_pq;
-	priority_queue<Found_Word, vector<Found_Word>, Name_Compare> alpha_pq;
-	
-	// EFFECTS: Given character, returns capitalized 
-	// version of the character
-	char capital(const char& c) {
-		if (c >= 65 && c <= 90) return c;
-		else if (c >= 97 && c <= 122) return c - 32;
-		else {
-			cout << "Invalid character\n";
-			assert(false);
-		}
-		return 0;
-	}
-	
-	// EFFECTS: Creates list of valid words
-	// Time Complexity: O(n)
-	void create_list(void) {
-		ifstream file;
-		// File can be found here: https://drive.google.com/file/d/1oGDf1wjWp5RF_X9C7HoedhIWMh5uJs8s/view
-		file.open("Collins_Scrabble_Words_(2019).txt");
-		// Throw exception if file is not open
-		File_Not_Open error1;
-		if (file.is_open() == false) throw error1;
-		string str_temp;
-		getline(file, str_temp);
-		while (file >> str_temp) {
-			list_of_words.push_back(str_temp);
-		}
-		file.close();
-	}
-
-	// EFFECTS: Returns true if all directions are equal
-	// Note: Start at directions[1] since directions[0] is always 'x'
-	bool all_duplicates(const vector<char>& directions){
-		if (directions.size() == 1) return true;
-		char x = directions[1];
-		//for (auto i : directions) {
-		//	if (x != i) return false;
-		//}
-		for (int i = 1; i < directions.size(); ++i) {
-			if (x != directions[i]) return false;
-		}
-		return true;
-	}
-
-public:
-	// Defualt Constructor
-	Word_Hunt_Solver(const Options& options) : search_depth(6) {
-		if (options.cardinal_output_mode == Cardinal_Output_Mode::k_Cardinal_Mode_On) cardinal_on = true;
-		if (options.index_output_mode == Index_Output_Mode::k_Index_Mode_On) index_on = true;
-		if (options.point_output_mode == Point_Output_Mode::k_Point_Mode_On) point_on = true;
-		if (options.alpha_output_mode == Alpha_Output_Mode::k_Alpha_Mode_On) alpha_on = true;
-		if (options.search_depth_output_mode == Search_Depth_Output_Mode::k_Search_Depth_Mode_On) search_depth_on = true;
-		if (options.board_mode == Board_Mode::k_Board_Mode_On) board_on = true;
-		if (options.linear_mode == Linear_Search_Only_Mode::k_Linear_Search_Mode_On) linear_on = true;
-		// Change search_depth value if specified
-		if (search_depth_on == true) search_depth = options.search_depth;
-		if (board_on == true) board_filename = options.board_filename;
-
-		// Word Hunt Mode
-		if (options.word_hunt_mode == Word_Hunt_Mode::k_Word_Hunt_Mode_On) word_hunt_mode_on = true;
-
-		// Specified length/first letter
-		if (options.specify_length_mode == Specify_Length_Mode::k_Specify_Length_Mode_on) specifed_length_on = true;
-		if (options.specify_first_letter_mode == Specify_First_Letter_Mode::k_Specify_First_Letter_Mode_On) specifed_first_letter_on = true;
-		if (specifed_length_on == true) specified_length = options.specified_length;
-		if (specifed_first_letter_on == true) specified_first_letters = options.specified_first_letters;
-
-		create_list();
-	}
-
-	// EFFECTS: Top level module to run Word_Hunt_Solver
-	void run() {
-		create_board();
-		print_board();
-		run_solver();
-		results();
-	}
-
-	// EFFECTS: Outputs cardinal directions for each found word
-	void cardinal_output(const Found_Word& found_word) {
-
-		if (linear_on) {
-			// check to see if all directions match
-			if (all_duplicates(found_word.cardinal_directions) == true) {
-				cout << found_word.word << "\n";
-				int row = found_word.coordinates.first;
-				int col = found_word.coordinates.second;
-				cout << "Start at row " << row << " col " << col << ", go ";
-				for (auto character : found_word.cardinal_directions) {
-					switch (character) {
-					case 'n':
-						cout << "N ";
-						break;
-					case 'e':
-						cout << "E ";
-						break;
-					case 's':
-						cout << "S ";
-						break;
-					case 'w':
-						cout << "W ";
-						break;
-					case 'a':
-						cout << "NE ";
-						break;
-					case 'b':
-						cout << "SE ";
-						break;
-					case 'c':
-						cout << "SW ";
-						break;
-					case 'd':
-						cout << "NW ";
-						break;
-					}
-				}
-				cout << "\n";
-				return;
-			}
-			else return;
-		}
-
-		int row = found_word.coordinates.first;
-		int col = found_word.coordinates.second;
-		cout << "Start at row " << row << " col " << col << ", go ";
-		for (auto character : found_word.cardinal_directions) {
-			switch (character) {
-			case 'n':
-				cout << "N ";
-				break;
-			case 'e':
-				cout << "E ";
-				break;
-			case 's':
-				cout << "S ";
-				break;
-			case 'w':
-				cout << "W ";
-				break;
-			case 'a':
-				cout << "NE ";
-				break;
-			case 'b':
-				cout << "SE ";
-				break;
-			case 'c':
-				cout << "SW ";
-				break;
-			case 'd':
-				cout << "NW ";
-				break;
-			}
-		}
-		cout << "\n";
-	}
-	
-	// EFFECTS: Outputs indexes in order of each found word
-	void index_output(const Found_Word& found_word) {
-		if (linear_on) {
-			// check to see if all directions match
-			if (all_duplicates(found_word.cardinal_directions) == true) {
-				cout << found_word.word << "\n";
-				int row = found_word.coordinates.first;
-				int col = found_word.coordinates.second;
-				cout << "Start at row " << row << " col " << col << ", go to ";
-				for (auto character : found_word.cardinal_directions) {
-					switch (character) {
-					case 'n':
-						cout << "row " << --row << " col " << col << ", ";
-						break;
-					case 'e':
-						cout << "row " << row << " col " << ++col << ", ";
-						break;
-					case 's':
-						cout << "row " << ++row << " col " << col << ", ";
-						break;
-					case 'w':
-						cout << "row " << row << " col " << --col << ", ";
-						break;
-					case 'a':
-						cout << "row " << --row << " col " << ++col << ", ";
-						break;
-					case 'b':
-						cout << "row " << ++row << " col " << ++col << ", ";
-						break;
-					case 'c':
-						cout << "row " << ++row << " col " << --col << ", ";
-						break;
-					case 'd':
-						cout << "row " << --row << " col " << --col << ", ";
-						break;
-					}
-				}
-				cout << "\n";
-				return;
-			}
-			else return;
-		}
-
-		
-		int row = found_word.coordinates.first;
-		int col = found_word.coordinates.second;
-		cout << "Start at row " << row << " col " << col << ", go to ";
-		for (auto character : found_word.cardinal_directions) {
-			switch (character) {
-			case 'n':
-				cout << "row " << --row << " col " << col << ", ";
-				break;
-			case 'e':
-				cout << "row " << row << " col " << ++col << ", ";
-				break;
-			case 's':
-				cout << "row " << ++row << " col " << col << ", ";
-				break;
-			case 'w':
-				cout << "row " << row << " col " << --col << ", ";
-				break;
-			case 'a':
-				cout << "row " << --row << " col " << ++col << ", ";
-				break;
-			case 'b':
-				cout << "row " << ++row << " col " << ++col << ", ";
-				break;
-			case 'c':
-				cout << "row " << ++row << " col " << --col << ", ";
-				break;
-			case 'd':
-				cout << "row " << --row << " col " << --col << ", ";
-				break;
-			}
-		}
-		cout << "\n";
-	}
-
-	// EFFECTS: Outputs results based on command line options
-	void results(void) {
-		cout << "---Summary---\n\n";
-		if (point_on) {
-			cout << "---Sorted by Word Length---\n";
-			if (linear_on == true) cout << "\n--Outputting Linear Solutions Only--\n";
-			int current_length = 0;
-			if (!point_pq.empty()) {
-				current_length = point_pq.top().length;
-				cout << "\n--Length: " << current_length << "--\n\n";
-			}
-			while (!point_pq.empty()) {
-				Found_Word found_word_temp = point_pq.top();
-				point_pq.pop();
-				// Separate lengths when printing
-				if (current_length != found_word_temp.length) {
-					cout << "\n--Length: " << found_word_temp.length << "--\n\n";
-					current_length = found_word_temp.length;
-				}
-				if (word_hunt_mode_on == true) {
-					if (found_word_temp.word_hunt_valid == false) continue;
-				}
-				if (linear_on == false) cout << found_word_temp.word << "\n";
-				if (cardinal_on) cardinal_output(found_word_temp);
-				if (index_on) index_output(found_word_temp);
-			}
-			cout << "\n";
-		}
-
-		if (alpha_on) {
-			cout << "---Sorted Alphabetically---\n\n";
-			if (linear_on == true) cout << "--Outputting Linear Solutions Only--\n";
-			while (!alpha_pq.empty()) {
-				Found_Word found_word_temp = alpha_pq.top();
-				alpha_pq.pop();
-				if (word_hunt_mode_on == true) {
-					if (found_word_temp.word_hunt_valid == false) continue;
-				}
-				if (linear_on == false) cout << found_word_temp.word << "\n";
-				if (cardinal_on) cardinal_output(found_word_temp);
-				if (index_on) index_output(found_word_temp);
-			}
-			cout << "\n";
-		}
-
-		if (point_on == false && alpha_on == false) {
-			if (linear_on == true) cout << "--Outputting Linear Solutions Only--\n";
-			for (auto found_word : found_word_vect) {
-				//cout << found_word.word << "\n";
-				if (word_hunt_mode_on == true) {
-					if (found_word.word_hunt_valid == false) continue;
-				}
-				if (linear_on == false) cout << found_word.word << "\n";
-				if (cardinal_on) cardinal_output(found_word);
-				if (index_on) index_output(found_word);
-			}
-			cout << "\n";
-		}
-	}
-	
-
-	// EFFECTS: Runs solver for each potential word in word list
-	void run_solver(void) {
-		for (auto word : list_of_words) {
-			if (specifed_length_on == true) {
-				if (word.length() != specified_length) continue;
-			}
-			if (specifed_first_letter_on == true) {
-				if (std::find(specified_first_letters.begin(), specified_first_letters.end(), word[0]) == specified_first_letters.end()) continue;
-			}
-			find_word(word);
-		}
-	}
-
-	// EFFECTS: Given word, finds all occurances of word inside board
-	void find_word(const string& word) {
-		// Case 1: word is longer than search_depth
-		if (word.length() > search_depth) return;
-		//bool word_is_apple = word == "APPLE" ? true : false; // for debugging purposes
-	
-		for (int row = 0; row < height; ++row) {
-			for (int col = 0; col < width; ++col) {
-				// Case 2: character in board != first letter in word
-				char current_letter = board[row][col];
-				if (current_letter != word[0]) continue;
-				// Case 3: character matches
-				look(word, row, col);
-			}
-		}
-	}
-
-	// EFFECTS: Looks in all directions to find word
-	void look(const string& word, int row, int col) {
-		int depth = 0;
-		int size_of_word = (int) word.length();
-		vector<char> directions;
-		pair<int, int> original;	// original = original coordinates of word (row,col)
-		original.first = row;
-		original.second = col;
-		look_recursive(word, row, col, depth, size_of_word, 'x', directions, original); // x is starting at beginning
-		
-	}
-
-	// EFFECTS: Given Found Word, returns coordinate vector by using found_word's 
-	// cardinal vector
-	vector<pair<int, int>> cardinal_to_coordinates(const Found_Word& found_word) {
-		vector<pair<int, int>> vect;
-		pair<int, int> p = found_word.coordinates; // Start off with original coordinates first
-		vect.push_back(p);
-		for (auto i : found_word.cardinal_directions) {
-			switch (i) {
-			case 'x': {
-				break;
-			}
-			case 'a': {
-				--p.first; ++p.second;
-				vect.push_back(p);
-				break;
-			}
-			case 'b': {
-				++p.first; ++p.second;
-				vect.push_back(p);
-				break;
-			}
-			case 'c': {
-				++p.first; --p.second;
-				vect.push_back(p);
-				break;
-			}
-			case 'd': {
-				--p.first; --p.second;
-				vect.push_back(p);
-				break;
-			}
-			case 'n': {
-				--p.first;
-				vect.push_back(p);
-				break;
-			}
-			case 'e': {
-				++p.second;
-				vect.push_back(p);
-				break;
-			}
-			case 's': {
-				++p.first;
-				vect.push_back(p);
-				break;
-			}
-			case 'w': {
-				--p.second;
-				vect.push_back(p);
-				break;
-			}
-			default:
-				assert(false);
-				break;
-			}
-		}
-		Coordinate_Compare inst1;
-		sort(vect.begin(), vect.end(), inst1);
-		return vect;
-	}
-
-	// EFFECTS: Returns true if found_word is "Word Hunt Valid"
-	bool is_word_hunt_valid(const Found_Word& found_word) {
-		// Case 1: found_word is length 2
-		if (found_word.word.length() == 2) return true;
-		// Case 2: General Case
-		pair<int, int> temp = found_word.coordinate_vect[0];
-		for (size_t i = 1; i < found_word.coordinate_vect.size(); ++i) {
-			if (temp == found_word.coordinate_vect[i]) return false;
-			temp = found_word.coordinate_vect[i];
-		}
-		return true;
-	}
-
-
-	// EFFECTS: Looks in all directions recursively
-	void look_recursive(const string word, int row, int col, int depth, 
-		int size_of_word, char prev, vector<char>& directions, const pair<int, int>& original) {
-
-		directions.push_back(prev);
-
-		// Base Case:
-		// Dimensions invalid
-		if (dimensions_valid(row, col) == false) {
-			directions.pop_back();
-			return;
-		}
-		// depth > search_depth
-		if (depth >= search_depth) {
-			directions.pop_back();
-			return;
-		}
-		// Not Found Case:
-		if (board[row][col] != word[depth]) {
-			directions.pop_back();
-			return;
-		}
-		// Found Case:
-		if (board[row][col] == word[word.length() - 1] && size_of_word - 1 == depth) {
-			//cout << word << endl;
-			//cout << "found!" << endl;
-
-			// We have original coordinates and directions 
-			// The dirty work is over :)
-			Found_Word found_word;
-			found_word.word = word;
-			found_word.length = size_of_word;
-			found_word.coordinates = original;
-			if (cardinal_on) found_word.cardinal_directions = directions;
-			assert(found_word.cardinal_directions.size() == found_word.word.length()); // for debugging purposes (sanity check)
-			if (word_hunt_mode_on == true) {
-				found_word.coordinate_vect = cardinal_to_coordinates(found_word);
-				if (is_word_hunt_valid(found_word) == true) found_word.word_hunt_valid = true;
-			}
-			found_word_vect.push_back(found_word);
-			if (point_on) point_pq.push(found_word);
-			if (alpha_on) alpha_pq.push(found_word);
-
-			directions.pop_back();
-			return;
-		}
-
-
-		// Recursive Case
-		// Note: a = NE, b = SE, c = SW, d = NW
-		switch (prev) {
-		case 'x': {
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'n': {
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'a':{
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'e': {
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'b': {
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			break;
-		}
-		case 's':{
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'c': {
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'w':{
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// Southeast
-			look_recursive(word, row + 1, col + 1, depth + 1, size_of_word, 'b', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		case 'd': {
-			// North
-			look_recursive(word, row - 1, col, depth + 1, size_of_word, 'n', directions, original);
-			// Northeast
-			look_recursive(word, row - 1, col + 1, depth + 1, size_of_word, 'a', directions, original);
-			// East
-			look_recursive(word, row, col + 1, depth + 1, size_of_word, 'e', directions, original);
-			// South
-			look_recursive(word, row + 1, col, depth + 1, size_of_word, 's', directions, original);
-			// Southwest
-			look_recursive(word, row + 1, col - 1, depth + 1, size_of_word, 'c', directions, original);
-			// West
-			look_recursive(word, row, col - 1, depth + 1, size_of_word, 'w', directions, original);
-			// Northwest
-			look_recursive(word, row - 1, col - 1, depth + 1, size_of_word, 'd', directions, original);
-			break;
-		}
-		default: {
-			assert(false);
-			break;
-		}
-		} // ...switch (prev)
-
-		directions.pop_back();
-	}
-
-
-	// EFFECTS: Given row and col returns true if dimensions are valid
-	bool dimensions_valid(int row, int col) {
-		if (row >= 0 && row < height && col >= 0 && col < width) return true;
-		return false;
-	}
-
-
-	// EFFECTS: Creates character board
-	void create_board(void) {
-		ifstream board_file;
-		board_file.open(board_filename);
-		// Throw exception if boardfile is not open
-		File_Not_Open error2;
-		if (board_file.is_open() == false) throw error2;
-		int w, h;
-		board_file >> w >> h;
-		width = w;
-		height = h;
-		char char_temp;
-		board.resize(height, vector<char>(width));
-		for (size_t row = 0; row < height; ++row) {
-			for (size_t col = 0; col < width; ++col) {
-				board_file >> char_temp;
-				board[row][col] = capital(char_temp);
-			}
-		}
-	}
-	
-	// EFFECTS: Prints board (taken from previous Word Search
-	// Puzzle Solver Project)
-	void print_board(void) {
-		cout << "---Word Hunt Puzzle Board Inputted---\n";
-		// Print column
-		cout << " " << " " << " ";
-		for (int col = 0; col < width; ++col) {
-			if (col < 10) cout << col << "  ";
-			else cout << col << " ";
-		}
-		cout << endl;
-		for (int row = 0; row < height; ++row) {
-			if (row < 10) cout << row << " " << " ";
-			else cout << row << " ";
-			for (int col = 0; col < width; ++col) {
-				cout << capital(board[row][col]) << " " << " ";
-			}
-			cout << endl;
-		}
-		cout << endl;
-		cout << "--Search Depth: " << search_depth << "--";
-		if (specifed_length_on) cout << "\n--Specified Length: " << specified_length << "--";
-		if (specifed_first_letter_on) {
-			cout << "\n--Specified First Letters: ";
-			for (auto letter : specified_first_letters) {
-				cout << letter << ", ";
-			}
-			cout << "--";
-		}
-
-
-		cout << "\n\n";
-	}
-	
-};
-
-// EFFECTS: Given character, returns capitalized 
-// version of the character
-char capital(const char& c) {
-	if (c >= 65 && c <= 90) return c;
-	else if (c >= 97 && c <= 122) return c - 32;
-	else {
-		cout << "Invalid character\n";
-		assert(false);
-	}
-	return 0;
-}
-
-
-void getMode(int argc, char* argv[], Options& options) {
-	// These are used with getopt_long()
-	opterr = false; // Let us handle all error output for command line options
-	int choice;
-	int index = 0;
-	option long_options[] = {
-		{ "cardinal", no_argument, nullptr, 'c' },
-		{ "index", no_argument, nullptr, 'i' },
-		{ "point", no_argument, nullptr, 'p' },
-		{ "alpha", no_argument, nullptr, 'a' },
-		{ "search-depth", required_argument, nullptr, 's' },
-		{ "board", required_argument, nullptr, 'b' },
-		{ "linear", no_argument, nullptr, 'l'},						// lowercase 'L'
-		{ "word-hunt", no_argument, nullptr, 'w'},
-		{ "specify-length", required_argument, nullptr, 'x'},
-		{ "specify-first-letter", required_argument, nullptr, 'y'},
-
-	};  // long_options[]
-
-	// TODO: Fill in the double quotes, to match the mode and help options.
-	// Note: s->no arguments, q->no arguments, h->no arguements, o->required arguments
-	while ((choice = getopt_long(argc, argv, "cipalws:b:x:y:", long_options, &index)) != -1) {
-		switch (choice) {
-		case 'c': {
-			options.cardinal_output_mode = Cardinal_Output_Mode::k_Cardinal_Mode_On;
-			break;
-		}
-		case 'i': {
-			options.index_output_mode = Index_Output_Mode::k_Index_Mode_On;
-			break;
-		}
-		case 'p': {
-			options.point_output_mode = Point_Output_Mode::k_Point_Mode_On;
-			break;
-		}
-		case 'a': {
-			options.alpha_output_mode = Alpha_Output_Mode::k_Alpha_Mode_On;
-			break;
-		}
-		case 's': {
-			options.search_depth_output_mode = Search_Depth_Output_Mode::k_Search_Depth_Mode_On;
-			string arg{ optarg };
-			options.search_depth = stoi(arg);
-			break;
-		}
-		case 'b': {
-			options.board_mode = Board_Mode::k_Board_Mode_On;
-			string arg{ optarg };
-			options.board_filename = arg;
-			break;
-		}
-		case 'l': {
-			options.linear_mode = Linear_Search_Only_Mode::k_Linear_Search_Mode_On;
-			break;
-		}
-		case 'w': {
-			options.word_hunt_mode = Word_Hunt_Mode::k_Word_Hunt_Mode_On;
-			break;
-		}
-		case 'x': {
-			options.specify_length_mode = Specify_Length_Mode::k_Specify_Length_Mode_on;
-			string arg{ optarg };
-			options.specified_length = stoi(arg);
-			break;
-		}
-		case 'y': {
-			options.specify_first_letter_mode = Specify_First_Letter_Mode::k_Specify_First_Letter_Mode_On;
-			string arg{ optarg };
-			//assert(arg.size() == 1);
-			//options.specified_first_letter = capital(arg[0]);
-			for (size_t i = 0; i < arg.length(); ++i) {
-				options.specified_first_letters.push_back(capital(arg[i]));
-			}
-			sort(options.specified_first_letters.begin(), options.specified_first_letters.end());
-			break;
-		}
-		default: {
-			cerr << "error: invalid option" << endl;
-			exit(1);
-		}
-		}
-	}
-}
-
-// Main function
-int main(int argc, char** argv) {
-	
-	Options options;
-	getMode(argc, argv, options);
-	Word_Hunt_Solver solver_1(options);
-	solver_1.run();
-
-	return 0;
-}
+// Word Hunt Solver (for GamePigeon iMessage Word Hunt Game)
+
+#include "Word_Hunt_Solver.h"
+#if defined(WHS_COUNT_ALLOCATIONS)
+// Lets --bench show how many allocations one solve makes
+#include "Allocation_Counter.h"
+#endif
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <new>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <charconv>
+#include <type_traits>
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+using namespace std;
+using namespace word_hunt;
+
+// Exception classes
+class Socket_Error{ /*...*/ };
+
+// Option enumerated classes of the command line program (the options of
+// the search are in Word_Hunt_Solver.h)
+enum class Cardinal_Output_Mode { kNone = 0, k_Cardinal_Mode_On, };					 // -c
+enum class Index_Output_Mode { kNone = 0, k_Index_Mode_On, };						 // -i
+enum class Board_Mode { kNone = 0, k_Board_Mode_On, };								 // -b
+enum class Compile_Dictionary_Mode { kNone = 0, k_Compile_Dictionary_Mode_On, };	 // --compile-dictionary
+enum class Batch_Mode { kNone = 0, k_Batch_Mode_On, };								 // --batch
+enum class Serve_Mode { kNone = 0, k_Serve_Mode_On, };								 // --serve
+enum class Quiet_Mode { kNone = 0, k_Quiet_Mode_On, };								 // -q
+enum class Format_Mode { k_Text_Format = 0, k_Jsonl_Format, k_Binary_Format, };		 // --format
+enum class Bench_Mode { kNone = 0, k_Bench_Mode_On, };								 // --bench
+
+// Long options without a short option
+enum Long_Only_Option { k_Compile_Dictionary_Option = 256, k_Batch_Option, k_Serve_Option, k_Score_Option, k_Top_Option, k_Format_Option,
+	k_Bench_Option, k_Seed_Option, k_Stats_Option, k_Edit_Option, k_Cache_Option, k_Cache_File_Option, };
+
+
+// Options struct
+// Every command line option: the options of the search (Core_Options) and
+// the ones only the command line program has
+struct Options : Core_Options {
+	Cardinal_Output_Mode cardinal_output_mode = Cardinal_Output_Mode::kNone;
+	Index_Output_Mode index_output_mode = Index_Output_Mode::kNone;
+	Board_Mode board_mode = Board_Mode::kNone;
+	Compile_Dictionary_Mode compile_dictionary_mode = Compile_Dictionary_Mode::kNone;
+	Batch_Mode batch_mode = Batch_Mode::kNone;
+	Serve_Mode serve_mode = Serve_Mode::kNone;
+	Quiet_Mode quiet_mode = Quiet_Mode::kNone;
+	Format_Mode format_mode = Format_Mode::k_Text_Format;
+	Bench_Mode bench_mode = Bench_Mode::kNone;
+
+	string board_filename = "board.txt";	// Default Board filename is "board.txt"
+	string compiled_dictionary_filename;
+	string batch_filename;					// "-" = standard input
+	string socket_path;
+	int bench_boards = 0;					// Boards per size and depth
+	uint32_t bench_seed = 1;
+	vector<Cell_Edit> edits;
+};
+
+
+// Output Writer
+// Formats everything the solver prints into one reusable buffer and hands it
+// to the OS a chunk at a time (a single write(2) per chunk), instead of going
+// through cout for every token. Nothing is flushed line by line.
+class Output_Writer {
+public:
+	explicit Output_Writer(int fd_in = 1) : fd(fd_in) { buffer.reserve(kChunkSize + 4096); }
+	Output_Writer(const Output_Writer&) = delete;
+	Output_Writer& operator=(const Output_Writer&) = delete;
+	~Output_Writer() { flush(); }
+
+	Output_Writer& operator<<(string_view text) {
+		buffer.append(text.data(), text.size());
+		if (buffer.size() >= kChunkSize) flush();
+		return *this;
+	}
+
+	Output_Writer& operator<<(char c) {
+		buffer.push_back(c);
+		if (buffer.size() >= kChunkSize) flush();
+		return *this;
+	}
+
+	template <class T, class = typename enable_if<is_integral<T>::value && !is_same<T, char>::value && !is_same<T, bool>::value>::type>
+	Output_Writer& operator<<(T value) {
+		char digits[24];
+		char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+		return *this << string_view(digits, end - digits);
+	}
+
+	// EFFECTS: Drops everything instead of writing it if on (used to time
+	// formatting without the cost of the terminal)
+	void discard(bool on) { discarding = on; }
+
+	// EFFECTS: Appends value as 4 little endian bytes
+	void put_u32(uint32_t value) {
+		char bytes[4] = { char(value), char(value >> 8), char(value >> 16), char(value >> 24) };
+		*this << string_view(bytes, 4);
+	}
+
+	// EFFECTS: Writes out everything buffered so far
+	void flush(void) {
+		if (discarding) {
+			buffer.clear();
+			return;
+		}
+#if defined(_WIN32)
+		cout.write(buffer.data(), buffer.size());
+		cout.flush();
+#else
+		size_t written = 0;
+		while (written < buffer.size()) {
+			ssize_t n = write(fd, buffer.data() + written, buffer.size() - written);
+			if (n < 0 && errno == EINTR) continue;
+			if (n <= 0) break;
+			written += (size_t)n;
+		}
+#endif
+		buffer.clear();
+	}
+
+private:
+	static constexpr size_t kChunkSize = 1 << 16;
+
+	int fd;
+	bool discarding = false;
+	string buffer;
+};
+
+
+// Seconds spent in each phase of solving boards (see timed_solve)
+struct Solve_Timing {
+	double parse = 0;
+	double search = 0;
+	double output = 0;
+};
+
+
+// EFFECTS: Given character, returns capitalized 
+// version of the character
+char capital(const char& c) {
+	if (c >= 65 && c <= 90) return c;
+	else if (c >= 97 && c <= 122) return c - 32;
+	else {
+		cout << "Invalid character\n";
+		assert(false);
+	}
+	return 0;
+}
+
+
+// Word Hunt Solver Class
+// The command line program on top of Word_Hunt_Core: reads boards from files,
+// standard input or the socket, solves them and prints the results
+class Word_Hunt_Solver : public Word_Hunt_Core {
+public:
+	// Defualt Constructor
+	// Note: Loads the dictionary unless shared_dictionary is given (lets
+	// several solvers share one Dictionary, see Solver_Server)
+	Word_Hunt_Solver(const Options& options, shared_ptr<const Dictionary> shared_dictionary = nullptr)
+		: Word_Hunt_Core(options, shared_dictionary) {
+		if (options.cardinal_output_mode == Cardinal_Output_Mode::k_Cardinal_Mode_On) cardinal_on = true;
+		if (options.index_output_mode == Index_Output_Mode::k_Index_Mode_On) index_on = true;
+		if (options.board_mode == Board_Mode::k_Board_Mode_On) board_on = true;
+		if (board_on == true) board_filename = options.board_filename;
+		if (options.quiet_mode == Quiet_Mode::k_Quiet_Mode_On) quiet_on = true;
+		format = options.format_mode;
+		if (options.edit_mode == Edit_Mode::k_Edit_Mode_On) edits = options.edits;
+		if (options.batch_mode == Batch_Mode::k_Batch_Mode_On) batch_filename = options.batch_filename;
+	}
+
+	// EFFECTS: Top level module to run Word_Hunt_Solver
+	void run() {
+		Phase_Clock clock(stats_on);
+		create_board();
+		// --edit is checked against the board here, the board size is not
+		// known while the options are read
+		for (const auto& edit : edits) {
+			if (dimensions_valid(edit.row, edit.col) == false) {
+				cerr << "error: --edit " << edit.row << "," << edit.col << " is off the " << height << " x " << width << " board" << endl;
+				exit(1);
+			}
+		}
+		clock.lap(phase_timing.parse);
+		if (text_on()) print_board();
+		clear_results();
+		run_solver();
+		clock.lap(phase_timing.search);
+		output_results(0);
+		if (edits.empty() == false) {
+			Board_Diff diff = apply_edits(edits);
+			clock.lap(phase_timing.search);
+			output_diff(diff);
+		}
+		out.flush();
+		clock.lap(phase_timing.output);
+		if (stats_on) print_stats();
+	}
+
+	// EFFECTS: Solves every board in batch file (or standard input) one
+	// after another. The dictionary and scratch buffers are reused, and the
+	// results of each board are flushed as soon as the board is solved
+	void run_batch() {
+		ifstream batch_file;
+		istream* in = &cin;
+		if (batch_filename != "-") {
+			batch_file.open(batch_filename);
+			// Throw exception if batch file is not open
+			File_Not_Open error3;
+			if (batch_file.is_open() == false) throw error3;
+			in = &batch_file;
+		}
+		Phase_Clock clock(stats_on);
+		for (int board_number = 0; ; ++board_number) {
+			// A board that is not valid is reported and skipped, the boards
+			// after it are still solved
+			try {
+				if (read_board(*in) == false) break;
+			}
+			catch (Invalid_Board&) {
+				cerr << "error: board " << board_number << " is not a valid board, skipped" << endl;
+				skip_board(*in);
+				continue;
+			}
+			clock.lap(phase_timing.parse);
+			clear_results();
+			if (text_on()) {
+				out << "---Board " << board_number << "---\n";
+				print_board();
+			}
+			run_solver();
+			clock.lap(phase_timing.search);
+			output_results(board_number);
+			out.flush();
+			clock.lap(phase_timing.output);
+		}
+		if (stats_on) print_stats();
+	}
+
+	// EFFECTS: Solves board given as text ("width height" then the letters)
+	// and appends results to response, encoded as described in Solver_Server
+	// Returns false if board_text is not a valid board
+	bool solve_request(const string& board_text, string& response) {
+		if (board_text_valid(board_text) == false) return false;
+		istringstream in(board_text);
+		if (read_board(in) == false) return false;
+		clear_results();
+		run_solver();
+		structured_results(response);
+		return true;
+	}
+
+	// EFFECTS: Solves board given as text and formats its results like run()
+	// (without the board), adding the seconds spent in each phase to timing
+	// Returns false if board_text is not a valid board
+	bool timed_solve(const string& board_text, Solve_Timing& timing) {
+		using Clock = chrono::steady_clock;
+		auto seconds = [](Clock::time_point a, Clock::time_point b) { return chrono::duration<double>(b - a).count(); };
+		Clock::time_point start = Clock::now();
+		// Stream is kept so a solve does not allocate once it has grown
+		board_stream.clear();
+		board_stream.str(board_text);
+		if (read_board(board_stream) == false) return false;
+		clear_results();
+		Clock::time_point parsed = Clock::now();
+		run_solver();
+		Clock::time_point searched = Clock::now();
+		output_results(0);
+		out.flush();
+		Clock::time_point finished = Clock::now();
+		timing.parse += seconds(start, parsed);
+		timing.search += seconds(parsed, searched);
+		timing.output += seconds(searched, finished);
+		return true;
+	}
+
+	// EFFECTS: Drops all output instead of writing it (see Output_Writer)
+	void discard_output(void) {
+		out.discard(true);
+	}
+
+private:
+	bool cardinal_on = false;
+	bool index_on = false;
+	bool board_on = false;
+	string board_filename = "board.txt";// Default Board filename is "board.txt"
+	bool quiet_on = false;
+	Format_Mode format = Format_Mode::k_Text_Format;
+	vector<Cell_Edit> edits;			// --edit, applied after the board is solved
+	string batch_filename = "-";
+
+	// Standard output (see Output_Writer)
+	Output_Writer out;
+	// Board text of timed_solve
+	istringstream board_stream;
+	// --stats: time spent in each phase, summed over every board
+	Solve_Timing phase_timing;
+
+	// Adds the seconds since the last lap to a phase, if on
+	class Phase_Clock {
+	public:
+		explicit Phase_Clock(bool on_in) : on(on_in) {
+			if (on) last = chrono::steady_clock::now();
+		}
+
+		void lap(double& seconds) {
+			if (on == false) return;
+			chrono::steady_clock::time_point now = chrono::steady_clock::now();
+			seconds += chrono::duration<double>(now - last).count();
+			last = now;
+		}
+
+	private:
+		bool on;
+		chrono::steady_clock::time_point last;
+	};
+
+	// EFFECTS: Prints --stats report to standard error, so it never mixes
+	// with the results
+	void print_stats(void) {
+		cerr << "---Search Stats---\n";
+		cerr << fixed << setprecision(3)
+			<< "create_list: " << create_list_seconds * 1e3 << " ms, create_board: " << phase_timing.parse * 1e3
+			<< " ms, run_solver: " << phase_timing.search * 1e3 << " ms, results: " << phase_timing.output * 1e3 << " ms\n";
+		cerr << "thread        nodes  off board  too deep  no word  revisit    matches  not word hunt\n";
+		Search_Stats total;
+		auto row = [](const string& name, const Search_Stats& stats) {
+			cerr << setw(6) << name << setw(13) << stats.nodes << setw(11) << stats.pruned_bounds
+				<< setw(10) << stats.pruned_depth << setw(9) << stats.pruned_letter
+				<< setw(9) << stats.pruned_revisit << setw(11) << stats.matches
+				<< setw(15) << stats.rejected_word_hunt << "\n";
+		};
+		for (size_t i = 0; i < thread_stats.size(); ++i) {
+			row(to_string(i), thread_stats[i]);
+			total += thread_stats[i];
+		}
+		if (thread_stats.size() > 1) row("total", total);
+	}
+
+	// EFFECTS: Returns true if board_text has a valid width and height (see
+	// board_size_valid) followed by exactly width * height letters
+	static bool board_text_valid(const string& board_text) {
+		istringstream in(board_text);
+		long long w, h;
+		if (!(in >> w >> h) || !board_size_valid(w, h)) return false;
+		long long letters = 0;
+		char c;
+		while (in >> c) {
+			if (!isalpha((unsigned char)c)) return false;
+			++letters;
+		}
+		return letters == w * h;
+	}
+
+	// EFFECTS: Appends "OK <count>" and one record per result to out, in the
+	// same order and with the same filters as results()
+	void structured_results(string& response) {
+		string records;
+		size_t count = 0;
+		for_each_result([&](const Found_Word& found_word) {
+			append_record(records, found_word);
+			++count;
+		});
+		response += "OK " + to_string(count) + "\n";
+		response += records;
+	}
+
+	// EFFECTS: Returns true if output is the human readable text
+	bool text_on(void) const {
+		return quiet_on == false && format == Format_Mode::k_Text_Format;
+	}
+
+	// EFFECTS: Outputs results of board board_number in selected format
+	void output_results(int board_number) {
+		if (quiet_on) count_results();
+		else if (format == Format_Mode::k_Jsonl_Format) jsonl_results(board_number);
+		else if (format == Format_Mode::k_Binary_Format) binary_results();
+		else results();
+	}
+
+	// EFFECTS: Outputs one JSON object per result, e.g.
+	// {"board":0,"word":"ANT","score":3,"path":[[0,0],[0,1],[1,1]]}
+	// Note: Words only have letters A-Z, so nothing needs escaping
+	void jsonl_results(int board_number) {
+		for_each_result([&](const Found_Word& found_word) {
+			out << "{\"board\":" << board_number << ",\"word\":\"" << dictionary->word(found_word.word_id)
+				<< "\",\"score\":" << found_word.points << ",\"path\":[";
+			bool first = true;
+			for_each_path_cell(found_word, [&](int row, int col) {
+				out << (first ? "[" : ",[") << row << ',' << col << ']';
+				first = false;
+			});
+			out << "]}\n";
+		});
+	}
+
+	// EFFECTS: Outputs results as little endian uint32 values: width, height
+	// and result count, then per result its word id, score, length and the
+	// cell (row * width + col) of every letter
+	void binary_results(void) {
+		out.put_u32((uint32_t)width);
+		out.put_u32((uint32_t)height);
+		out.put_u32((uint32_t)result_count());
+		for_each_result([&](const Found_Word& found_word) {
+			out.put_u32(found_word.word_id);
+			out.put_u32(found_word.points);
+			out.put_u32(found_word.length);
+			for_each_path_cell(found_word, [&](int row, int col) { out.put_u32((uint32_t)(row * width + col)); });
+		});
+	}
+
+	// EFFECTS: Outputs number of results that pass -w and -l (-q), without
+	// sorting or formatting any of them
+	void count_results(void) {
+		out << result_count() << '\n';
+	}
+
+	// EFFECTS: Appends "word \t path \t directions" record to out
+	void append_record(string& response, const Found_Word& found_word) {
+		response += dictionary->word(found_word.word_id);
+		response += '\t';
+		bool first = true;
+		for_each_path_cell(found_word, [&](int row, int col) {
+			if (first == false) response += ' ';
+			response += to_string(row) + "," + to_string(col);
+			first = false;
+		});
+		response += '\t';
+		for (int i = 0; i < found_word.length - 1; ++i) {
+			if (i > 0) response += ' ';
+			response += kDirections[path_step(found_word, i)].label;
+		}
+		response += '\n';
+	}
+
+	// EFFECTS: Outputs cardinal directions for each found word
+	void cardinal_output(const Found_Word& found_word) {
+
+		if (linear_on) {
+			// check to see if all directions match
+			if (path_is_linear(found_word) == false) return;
+			out << dictionary->word(found_word.word_id) << "\n";
+		}
+
+		out << "Start at row " << found_word.row << " col " << found_word.col << ", go ";
+		for (int i = 0; i < found_word.length - 1; ++i) {
+			out << kDirections[path_step(found_word, i)].label << " ";
+		}
+		out << "\n";
+	}
+
+	// EFFECTS: Outputs indexes in order of each found word
+	void index_output(const Found_Word& found_word) {
+		if (linear_on) {
+			// check to see if all directions match
+			if (path_is_linear(found_word) == false) return;
+			out << dictionary->word(found_word.word_id) << "\n";
+		}
+
+		bool first = true;
+		for_each_path_cell(found_word, [&](int row, int col) {
+			if (first) out << "Start at row " << row << " col " << col << ", go to ";
+			else out << "row " << row << " col " << col << ", ";
+			first = false;
+		});
+		out << "\n";
+	}
+
+	// EFFECTS: Outputs header of words that are length letters long in -p
+	// output (with their points if scoring like Word Hunt)
+	void length_header(int length) {
+		out << "\n--Length: " << length;
+		if (word_hunt_scoring_on) out << " (" << score_table(length) << " points)";
+		out << "--\n\n";
+	}
+
+	// EFFECTS: Outputs results based on command line options
+	void results(void) {
+		sort_results();
+		out << "---Summary---\n\n";
+		if (point_on) {
+			out << "---Sorted by Word Length---\n";
+			if (linear_on == true) out << "\n--Outputting Linear Solutions Only--\n";
+			// A length header is printed only ahead of a shown result, so
+			// every engine prints the same headers whether or not it kept
+			// the paths that -w and -l hide
+			int current_length = 0;
+			for (uint32_t i : point_order) {
+				const Found_Word& found_word_temp = found_words[i];
+				if (shown(found_word_temp) == false) continue;
+				// Separate lengths when printing
+				if (current_length != found_word_temp.length) {
+					current_length = found_word_temp.length;
+					length_header(current_length);
+				}
+				if (linear_on == false) out << dictionary->word(found_word_temp.word_id) << "\n";
+				if (cardinal_on) cardinal_output(found_word_temp);
+				if (index_on) index_output(found_word_temp);
+			}
+			out << "\n";
+		}
+
+		if (alpha_on) {
+			out << "---Sorted Alphabetically---\n\n";
+			if (linear_on == true) out << "--Outputting Linear Solutions Only--\n";
+			for (uint32_t i : alpha_order) {
+				const Found_Word& found_word_temp = found_words[i];
+				if (word_hunt_mode_on == true) {
+					if (found_word_temp.word_hunt_valid == false) continue;
+				}
+				if (linear_on == false) out << dictionary->word(found_word_temp.word_id) << "\n";
+				if (cardinal_on) cardinal_output(found_word_temp);
+				if (index_on) index_output(found_word_temp);
+			}
+			out << "\n";
+		}
+
+		if (point_on == false && alpha_on == false) {
+			if (linear_on == true) out << "--Outputting Linear Solutions Only--\n";
+			for (size_t i = 0; i < found_words.size(); ++i) {
+				const Found_Word& found_word = found_words[i];
+				if (word_hunt_mode_on == true) {
+					if (found_word.word_hunt_valid == false) continue;
+				}
+				if (linear_on == false) out << dictionary->word(found_word.word_id) << "\n";
+				if (cardinal_on) cardinal_output(found_word);
+				if (index_on) index_output(found_word);
+			}
+			out << "\n";
+		}
+	}
+
+	// EFFECTS: Outputs diff of apply_edits in selected format: the board and
+	// the words added and removed (text), one JSON object (jsonl), the
+	// counts and word ids (bin) or just the counts (-q)
+	void output_diff(const Board_Diff& diff) {
+		if (quiet_on) {
+			out << diff.added.size() << ' ' << diff.removed.size() << '\n';
+		}
+		else if (format == Format_Mode::k_Jsonl_Format) {
+			auto words = [&](const vector<uint32_t>& ids) {
+				out << '[';
+				for (size_t i = 0; i < ids.size(); ++i) {
+					if (i > 0) out << ',';
+					out << '"' << dictionary->word(ids[i]) << '"';
+				}
+				out << ']';
+			};
+			out << "{\"board\":0,\"added\":";
+			words(diff.added);
+			out << ",\"removed\":";
+			words(diff.removed);
+			out << "}\n";
+		}
+		else if (format == Format_Mode::k_Binary_Format) {
+			out.put_u32((uint32_t)diff.added.size());
+			for (uint32_t id : diff.added) out.put_u32(id);
+			out.put_u32((uint32_t)diff.removed.size());
+			for (uint32_t id : diff.removed) out.put_u32(id);
+		}
+		else {
+			out << "---Board After Edits---\n";
+			print_board();
+			out << "---Words Added---\n";
+			for (uint32_t id : diff.added) out << dictionary->word(id) << '\n';
+			out << "\n---Words Removed---\n";
+			for (uint32_t id : diff.removed) out << dictionary->word(id) << '\n';
+			out << '\n';
+		}
+	}
+
+	// EFFECTS: Creates character board
+	void create_board(void) {
+		ifstream board_file;
+		board_file.open(board_filename);
+		// Throw exception if boardfile is not open
+		File_Not_Open error2;
+		if (board_file.is_open() == false) throw error2;
+		bool board_read = false;
+		try {
+			board_read = read_board(board_file);
+		}
+		catch (Invalid_Board&) {}
+		if (board_read == false) {
+			cerr << "error: " << board_filename << " is not a valid board" << endl;
+			exit(1);
+		}
+	}
+
+	// EFFECTS: Reads next board ("width height" followed by the letters) from
+	// in. Returns false if there is no board left
+	// Throws Invalid_Board (board left empty) if the board does not have a
+	// valid width and height (see board_size_valid) followed by width * height
+	// letters
+	bool read_board(istream& in) {
+		if ((in >> ws).peek() == EOF) return false;
+		long long w, h;
+		Invalid_Board error4;
+		if (!(in >> w >> h) || !board_size_valid(w, h)) {
+			in.clear();
+			clear_board(0, 0);
+			throw error4;
+		}
+		clear_board((int)w, (int)h);
+		char char_temp;
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) {
+				if (!(in >> char_temp) || !isalpha((unsigned char)char_temp)) {
+					clear_board(0, 0);
+					throw error4;
+				}
+				board[cell_index(row, col)] = capital(char_temp);
+			}
+		}
+		select_fixed_search();
+		return true;
+	}
+
+	// EFFECTS: Skips what is left of a board read_board threw on, up to the
+	// next word starting with a digit (the width of the next board)
+	static void skip_board(istream& in) {
+		in.clear();
+		string word;
+		while (true) {
+			int c = (in >> ws).peek();
+			if (c == EOF || isdigit(c)) return;
+			in >> word;
+		}
+	}
+
+	// EFFECTS: Prints board (taken from previous Word Search
+	// Puzzle Solver Project)
+	void print_board(void) {
+		out << "---Word Hunt Puzzle Board Inputted---\n";
+		// Print column
+		out << "   ";
+		for (int col = 0; col < width; ++col) {
+			if (col < 10) out << col << "  ";
+			else out << col << " ";
+		}
+		out << '\n';
+		for (int row = 0; row < height; ++row) {
+			if (row < 10) out << row << "  ";
+			else out << row << " ";
+			for (int col = 0; col < width; ++col) {
+				out << capital(at(row, col)) << "  ";
+			}
+			out << '\n';
+		}
+		out << '\n';
+		out << "--Search Depth: " << search_depth << "--";
+		if (specifed_length_on) out << "\n--Specified Length: " << specified_length << "--";
+		if (specifed_first_letter_on) {
+			out << "\n--Specified First Letters: ";
+			for (auto letter : specified_first_letters) {
+				out << letter << ", ";
+			}
+			out << "--";
+		}
+
+
+		out << "\n\n";
+	}
+};
+
+
+#if !defined(_WIN32)
+// Solver Server
+// Long running solver that loads the dictionary once and answers boards sent
+// over a Unix domain socket. Connections are handed to a fixed pool of
+// worker threads, each owning its own Word_Hunt_Solver (all sharing the one
+// Dictionary), so requests on different connections are solved concurrently.
+//
+// Protocol (all lengths are 4 byte little endian unsigned integers):
+//   Request:  length, then a board written like a board file
+//             ("width height" followed by the letters)
+//   Response: length, then either
+//             "OK <count>\n" followed by count records, or "ERR <reason>\n"
+// Record (one per found word, order and filters follow -p/-a/-w/-l/-x/-y/-s):
+//   word \t path \t directions \n
+//   path is "row,col" of every letter separated by spaces, directions are
+//   the cardinal directions (N, NE, E, ...) separated by spaces
+// A connection may send any number of requests one after another.
+class Solver_Server {
+public:
+	Solver_Server(const Options& options, shared_ptr<const Dictionary> dictionary_in, int thread_count_in)
+		: solver_options(options), dictionary(dictionary_in), thread_count(max(1, thread_count_in)) {
+		// Each worker searches on its own thread
+		solver_options.threads_mode = Threads_Mode::kNone;
+	}
+
+	// EFFECTS: Listens on socket_path and serves requests until the process
+	// is killed. Throws Socket_Error if the socket cannot be set up
+	void serve(const string& socket_path) {
+		Socket_Error error;
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+		if (socket_path.length() >= sizeof(address.sun_path)) throw error;
+		strcpy(address.sun_path, socket_path.c_str());
+
+		int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listen_fd < 0) throw error;
+		unlink(socket_path.c_str());
+		if (::bind(listen_fd, (sockaddr*)&address, sizeof(address)) != 0 || listen(listen_fd, 128) != 0) {
+			close(listen_fd);
+			throw error;
+		}
+		// A client hanging up mid response should not kill the server
+		signal(SIGPIPE, SIG_IGN);
+
+		vector<thread> workers;
+		for (int i = 0; i < thread_count; ++i) workers.emplace_back(&Solver_Server::work, this);
+		while (true) {
+			int fd = accept(listen_fd, nullptr, nullptr);
+			if (fd < 0) {
+				if (errno == EINTR) continue;
+				break;
+			}
+			{
+				lock_guard<mutex> guard(queue_lock);
+				pending_connections.push_back(fd);
+			}
+			queue_ready.notify_one();
+		}
+		close(listen_fd);
+		{
+			lock_guard<mutex> guard(queue_lock);
+			shutting_down = true;
+		}
+		queue_ready.notify_all();
+		for (auto& worker : workers) worker.join();
+	}
+
+private:
+	// Largest request accepted (1 MB is far more than any board needs)
+	static constexpr uint32_t kMaxRequestSize = 1 << 20;
+
+	Options solver_options;
+	shared_ptr<const Dictionary> dictionary;
+	int thread_count;
+
+	mutex queue_lock;
+	condition_variable queue_ready;
+	deque<int> pending_connections;
+	bool shutting_down = false;
+
+	// EFFECTS: Worker thread, serves one connection at a time
+	void work(void) {
+		Word_Hunt_Solver solver(solver_options, dictionary);
+		string request;
+		string response;
+		while (true) {
+			int fd;
+			{
+				unique_lock<mutex> guard(queue_lock);
+				queue_ready.wait(guard, [this] { return shutting_down || !pending_connections.empty(); });
+				if (pending_connections.empty()) return;
+				fd = pending_connections.front();
+				pending_connections.pop_front();
+			}
+			serve_connection(solver, fd, request, response);
+			close(fd);
+		}
+	}
+
+	// EFFECTS: Answers requests on fd until client closes the connection
+	void serve_connection(Word_Hunt_Solver& solver, int fd, string& request, string& response) {
+		unsigned char length_bytes[4];
+		while (read_full(fd, (char*)length_bytes, 4)) {
+			uint32_t length = (uint32_t)length_bytes[0] | (uint32_t)length_bytes[1] << 8
+				| (uint32_t)length_bytes[2] << 16 | (uint32_t)length_bytes[3] << 24;
+			response.clear();
+			if (length > kMaxRequestSize) {
+				response = "ERR request too large\n";
+				write_response(fd, response);
+				return;
+			}
+			request.resize(length);
+			if (!read_full(fd, &request[0], length)) return;
+			if (solver.solve_request(request, response) == false) {
+				response = "ERR invalid board\n";
+			}
+			if (!write_response(fd, response)) return;
+		}
+	}
+
+	// EFFECTS: Writes length prefixed response to fd. Returns false on error
+	static bool write_response(int fd, const string& response) {
+		uint32_t length = (uint32_t)response.size();
+		char length_bytes[4] = { (char)(length & 0xFF), (char)(length >> 8 & 0xFF),
+			(char)(length >> 16 & 0xFF), (char)(length >> 24 & 0xFF) };
+		return write_full(fd, length_bytes, 4) && write_full(fd, response.data(), response.size());
+	}
+
+	// EFFECTS: Reads exactly size bytes. Returns false on error or end of file
+	static bool read_full(int fd, char* data, size_t size) {
+		while (size > 0) {
+			ssize_t n = read(fd, data, size);
+			if (n < 0 && errno == EINTR) continue;
+			if (n <= 0) return false;
+			data += n;
+			size -= (size_t)n;
+		}
+		return true;
+	}
+
+	// EFFECTS: Writes exactly size bytes. Returns false on error
+	static bool write_full(int fd, const char* data, size_t size) {
+		while (size > 0) {
+			ssize_t n = write(fd, data, size);
+			if (n < 0 && errno == EINTR) continue;
+			if (n <= 0) return false;
+			data += n;
+			size -= (size_t)n;
+		}
+		return true;
+	}
+};
+#endif
+
+
+// Solver Bench
+// Times the solver on random boards: for every board size and search depth
+// it solves bench_boards boards drawn from a seeded generator (letters follow
+// English letter frequencies, so boards look like real games) with the other
+// options given, and reports each phase, throughput and latency percentiles.
+// The same seed always gives the same boards, so runs can be compared across
+// builds and engines (-e, -t).
+class Solver_Bench {
+public:
+	explicit Solver_Bench(const Options& options_in) : options(options_in) {}
+
+	// EFFECTS: Runs every size and depth and prints the report
+	void run(void) {
+		using Clock = chrono::steady_clock;
+		Clock::time_point start = Clock::now();
+		auto dictionary = make_shared<Dictionary>();
+		dictionary->load(options.dictionary_filename);
+		double load_seconds = chrono::duration<double>(Clock::now() - start).count();
+
+		vector<int> depths = { 4, 6, 8 };
+		if (options.search_depth_output_mode == Search_Depth_Output_Mode::k_Search_Depth_Mode_On) {
+			depths = { options.search_depth };
+		}
+
+		cout << "---Benchmark---\n";
+		cout << "Dictionary: " << options.dictionary_filename << ", loaded in "
+			<< fixed << setprecision(2) << load_seconds * 1e3 << " ms\n";
+		cout << "Seed: " << options.bench_seed << ", boards per run: " << options.bench_boards << "\n\n";
+		cout << " size depth  words/board   boards/s  parse ms search ms output ms   p50 us   p90 us   p99 us   max us";
+#if defined(WHS_COUNT_ALLOCATIONS)
+		cout << "  allocs/board";
+#endif
+		cout << "\n";
+		for (int size : { 4, 5, 10, 20 }) {
+			for (int depth : depths) run_one(dictionary, size, depth);
+		}
+	}
+
+private:
+	Options options;
+
+	// EFFECTS: Solves bench_boards random size x size boards at depth and
+	// prints one report line
+	void run_one(const shared_ptr<const Dictionary>& dictionary, int size, int depth) {
+		Options run_options = options;
+		run_options.search_depth_output_mode = Search_Depth_Output_Mode::k_Search_Depth_Mode_On;
+		run_options.search_depth = depth;
+		Word_Hunt_Solver solver(run_options, dictionary);
+		solver.discard_output();
+
+		// Every size and depth sees the same sequence for a seed
+		mt19937 generator(options.bench_seed + size);
+		discrete_distribution<int> letter(begin(kLetterFrequencies), end(kLetterFrequencies));
+
+		Solve_Timing timing;
+		vector<double> latencies;
+		size_t words = 0;
+		string board_text;
+#if defined(WHS_COUNT_ALLOCATIONS)
+		uint64_t allocations = 0;
+#endif
+		for (int board_number = 0; board_number < options.bench_boards; ++board_number) {
+			board_text = to_string(size) + " " + to_string(size) + "\n";
+			for (int i = 0; i < size * size; ++i) board_text += char('A' + letter(generator));
+			double before = timing.parse + timing.search + timing.output;
+#if defined(WHS_COUNT_ALLOCATIONS)
+			uint64_t allocations_before = g_allocation_count.load(memory_order_relaxed);
+			solver.timed_solve(board_text, timing);
+			// The first board grows the scratch buffers, so it is not counted
+			if (board_number > 0) allocations += g_allocation_count.load(memory_order_relaxed) - allocations_before;
+#else
+			solver.timed_solve(board_text, timing);
+#endif
+			latencies.push_back(timing.parse + timing.search + timing.output - before);
+			words += solver.result_count();
+		}
+
+		sort(latencies.begin(), latencies.end());
+		double total = timing.parse + timing.search + timing.output;
+		cout << setw(5) << to_string(size) + "x" + to_string(size) << setw(6) << depth
+			<< fixed << setprecision(1) << setw(13) << double(words) / latencies.size()
+			<< setw(11) << latencies.size() / total
+			<< setprecision(2) << setw(10) << timing.parse * 1e3
+			<< setw(10) << timing.search * 1e3
+			<< setw(10) << timing.output * 1e3
+			<< setprecision(1) << setw(9) << percentile(latencies, 50) * 1e6
+			<< setw(9) << percentile(latencies, 90) * 1e6
+			<< setw(9) << percentile(latencies, 99) * 1e6
+			<< setw(9) << latencies.back() * 1e6;
+#if defined(WHS_COUNT_ALLOCATIONS)
+		cout << setprecision(2) << setw(14) << double(allocations) / max(1, options.bench_boards - 1);
+#endif
+		cout << "\n";
+	}
+
+	// EFFECTS: Returns p-th percentile (nearest rank) of sorted values
+	static double percentile(const vector<double>& sorted, int p) {
+		size_t rank = (sorted.size() * p + 99) / 100;
+		return sorted[rank == 0 ? 0 : rank - 1];
+	}
+
+	// Relative frequency of A-Z in English text (per 1000 letters)
+	static constexpr int kLetterFrequencies[26] = {
+		82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24,
+		67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1,
+	};
+};
+
+void getMode(int argc, char* argv[], Options& options) {
+	// These are used with getopt_long()
+	opterr = false; // Let us handle all error output for command line options
+	int choice;
+	int index = 0;
+	option long_options[] = {
+		{ "cardinal", no_argument, nullptr, 'c' },
+		{ "index", no_argument, nullptr, 'i' },
+		{ "point", no_argument, nullptr, 'p' },
+		{ "alpha", no_argument, nullptr, 'a' },
+		{ "search-depth", required_argument, nullptr, 's' },
+		{ "board", required_argument, nullptr, 'b' },
+		{ "linear", no_argument, nullptr, 'l'},						// lowercase 'L'
+		{ "word-hunt", no_argument, nullptr, 'w'},
+		{ "specify-length", required_argument, nullptr, 'x'},
+		{ "specify-first-letter", required_argument, nullptr, 'y'},
+		{ "engine", required_argument, nullptr, 'e'},
+		{ "dictionary", required_argument, nullptr, 'd'},
+		{ "compile-dictionary", required_argument, nullptr, k_Compile_Dictionary_Option},
+		{ "threads", required_argument, nullptr, 't'},
+		{ "batch", required_argument, nullptr, k_Batch_Option},
+		{ "serve", required_argument, nullptr, k_Serve_Option},
+		{ "unique", no_argument, nullptr, 'u'},
+		{ "quiet", no_argument, nullptr, 'q'},
+		{ "format", required_argument, nullptr, k_Format_Option},
+		{ "bench", required_argument, nullptr, k_Bench_Option},
+		{ "seed", required_argument, nullptr, k_Seed_Option},
+		{ "stats", no_argument, nullptr, k_Stats_Option},
+		{ "score", required_argument, nullptr, k_Score_Option},
+		{ "top", required_argument, nullptr, k_Top_Option},
+		{ "edit", required_argument, nullptr, k_Edit_Option},
+		{ "cache", required_argument, nullptr, k_Cache_Option},
+		{ "cache-file", required_argument, nullptr, k_Cache_File_Option},
+
+	};  // long_options[]
+
+	// TODO: Fill in the double quotes, to match the mode and help options.
+	// Note: s->no arguments, q->no arguments, h->no arguements, o->required arguments
+	while ((choice = getopt_long(argc, argv, "cipalwuqs:b:x:y:e:d:t:", long_options, &index)) != -1) {
+		switch (choice) {
+		case 'c': {
+			options.cardinal_output_mode = Cardinal_Output_Mode::k_Cardinal_Mode_On;
+			break;
+		}
+		case 'i': {
+			options.index_output_mode = Index_Output_Mode::k_Index_Mode_On;
+			break;
+		}
+		case 'p': {
+			options.point_output_mode = Point_Output_Mode::k_Point_Mode_On;
+			break;
+		}
+		case 'a': {
+			options.alpha_output_mode = Alpha_Output_Mode::k_Alpha_Mode_On;
+			break;
+		}
+		case 's': {
+			options.search_depth_output_mode = Search_Depth_Output_Mode::k_Search_Depth_Mode_On;
+			string arg{ optarg };
+			options.search_depth = stoi(arg);
+			break;
+		}
+		case 'b': {
+			options.board_mode = Board_Mode::k_Board_Mode_On;
+			string arg{ optarg };
+			options.board_filename = arg;
+			break;
+		}
+		case 'l': {
+			options.linear_mode = Linear_Search_Only_Mode::k_Linear_Search_Mode_On;
+			break;
+		}
+		case 'w': {
+			options.word_hunt_mode = Word_Hunt_Mode::k_Word_Hunt_Mode_On;
+			break;
+		}
+		case 'u': {
+			options.unique_mode = Unique_Mode::k_Unique_Mode_On;
+			break;
+		}
+		case 'q': {
+			options.quiet_mode = Quiet_Mode::k_Quiet_Mode_On;
+			break;
+		}
+		case 'x': {
+			options.specify_length_mode = Specify_Length_Mode::k_Specify_Length_Mode_on;
+			string arg{ optarg };
+			options.specified_length = stoi(arg);
+			break;
+		}
+		case 'y': {
+			options.specify_first_letter_mode = Specify_First_Letter_Mode::k_Specify_First_Letter_Mode_On;
+			string arg{ optarg };
+			//assert(arg.size() == 1);
+			//options.specified_first_letter = capital(arg[0]);
+			for (size_t i = 0; i < arg.length(); ++i) {
+				if (!isalpha((unsigned char)arg[i])) {
+					cerr << "error: -y needs letters" << endl;
+					exit(1);
+				}
+				options.specified_first_letters.push_back(capital(arg[i]));
+			}
+			sort(options.specified_first_letters.begin(), options.specified_first_letters.end());
+			break;
+		}
+		case 'e': {
+			string arg{ optarg };
+			if (arg == "trie") options.engine_mode = Engine_Mode::k_Trie_Engine;
+			else if (arg == "scan") options.engine_mode = Engine_Mode::k_Scan_Engine;
+			else if (arg == "iterative") options.engine_mode = Engine_Mode::k_Iterative_Engine;
+			else if (arg == "linear") options.engine_mode = Engine_Mode::k_Linear_Engine;
+			else {
+				cerr << "error: invalid engine" << endl;
+				exit(1);
+			}
+			break;
+		}
+		case 'd': {
+			options.dictionary_mode = Dictionary_Mode::k_Dictionary_Mode_On;
+			string arg{ optarg };
+			options.dictionary_filename = arg;
+			break;
+		}
+		case 't': {
+			options.threads_mode = Threads_Mode::k_Threads_Mode_On;
+			string arg{ optarg };
+			options.thread_count = stoi(arg);
+			break;
+		}
+		case k_Batch_Option: {
+			options.batch_mode = Batch_Mode::k_Batch_Mode_On;
+			string arg{ optarg };
+			options.batch_filename = arg;
+			break;
+		}
+		case k_Serve_Option: {
+			options.serve_mode = Serve_Mode::k_Serve_Mode_On;
+			string arg{ optarg };
+			options.socket_path = arg;
+			break;
+		}
+		case k_Score_Option: {
+			string arg{ optarg };
+			if (arg == "length") options.scoring_mode = Scoring_Mode::k_Length_Scoring;
+			else if (arg == "word-hunt") options.scoring_mode = Scoring_Mode::k_Word_Hunt_Scoring;
+			else {
+				cerr << "error: invalid scoring" << endl;
+				exit(1);
+			}
+			break;
+		}
+		case k_Top_Option: {
+			options.top_mode = Top_Mode::k_Top_Mode_On;
+			string arg{ optarg };
+			options.top_count = stoi(arg);
+			if (options.top_count <= 0) {
+				cerr << "error: --top needs a positive count" << endl;
+				exit(1);
+			}
+			break;
+		}
+		case k_Format_Option: {
+			string arg{ optarg };
+			if (arg == "text") options.format_mode = Format_Mode::k_Text_Format;
+			else if (arg == "jsonl") options.format_mode = Format_Mode::k_Jsonl_Format;
+			else if (arg == "bin") options.format_mode = Format_Mode::k_Binary_Format;
+			else {
+				cerr << "error: invalid format" << endl;
+				exit(1);
+			}
+			break;
+		}
+		case k_Bench_Option: {
+			options.bench_mode = Bench_Mode::k_Bench_Mode_On;
+			string arg{ optarg };
+			options.bench_boards = stoi(arg);
+			if (options.bench_boards <= 0) {
+				cerr << "error: --bench needs a positive number of boards" << endl;
+				exit(1);
+			}
+			break;
+		}
+		case k_Seed_Option: {
+			string arg{ optarg };
+			options.bench_seed = (uint32_t)stoul(arg);
+			break;
+		}
+		case k_Stats_Option: {
+			options.stats_mode = Stats_Mode::k_Stats_Mode_On;
+			break;
+		}
+		case k_Cache_Option: {
+			options.cache_mode = Cache_Mode::k_Cache_Mode_On;
+			string arg{ optarg };
+			options.cache_entries = stoi(arg);
+			if (options.cache_entries <= 0) {
+				cerr << "error: --cache needs a positive number of boards" << endl;
+				exit(1);
+			}
+			break;
+		}
+		case k_Cache_File_Option: {
+			options.cache_mode = Cache_Mode::k_Cache_Mode_On;
+			string arg{ optarg };
+			options.cache_filename = arg;
+			break;
+		}
+		case k_Edit_Option: {
+			options.edit_mode = Edit_Mode::k_Edit_Mode_On;
+			// ROW,COL,LETTER
+			string arg{ optarg };
+			Cell_Edit edit;
+			char comma1 = 0, comma2 = 0;
+			istringstream in(arg);
+			if (!(in >> edit.row >> comma1 >> edit.col >> comma2 >> edit.letter) || comma1 != ',' || comma2 != ','
+				|| edit.row < 0 || edit.col < 0 || !isalpha((unsigned char)edit.letter)) {
+				cerr << "error: --edit needs ROW,COL,LETTER" << endl;
+				exit(1);
+			}
+			edit.letter = capital(edit.letter);
+			options.edits.push_back(edit);
+			break;
+		}
+		case k_Compile_Dictionary_Option: {
+			options.compile_dictionary_mode = Compile_Dictionary_Mode::k_Compile_Dictionary_Mode_On;
+			string arg{ optarg };
+			options.compiled_dictionary_filename = arg;
+			break;
+		}
+		default: {
+			cerr << "error: invalid option" << endl;
+			exit(1);
+		}
+		}
+	}
+	// Edits are written to the one board of -b
+	if (options.edit_mode == Edit_Mode::k_Edit_Mode_On
+		&& (options.batch_mode == Batch_Mode::k_Batch_Mode_On || options.serve_mode == Serve_Mode::k_Serve_Mode_On
+			|| options.bench_mode == Bench_Mode::k_Bench_Mode_On)) {
+		cerr << "error: --edit can not be used with --batch, --serve or --bench" << endl;
+		exit(1);
+	}
+}
+
+// Main function
+int main(int argc, char** argv) {
+	
+	Options options;
+	getMode(argc, argv, options);
+	// Compile dictionary and exit
+	if (options.compile_dictionary_mode == Compile_Dictionary_Mode::k_Compile_Dictionary_Mode_On) {
+		Dictionary dictionary;
+		dictionary.load(options.dictionary_filename);
+		dictionary.write_image(options.compiled_dictionary_filename);
+		return 0;
+	}
+	// Time solver on random boards
+	if (options.bench_mode == Bench_Mode::k_Bench_Mode_On) {
+		Solver_Bench bench(options);
+		bench.run();
+		return 0;
+	}
+	// Serve boards over Unix domain socket
+	if (options.serve_mode == Serve_Mode::k_Serve_Mode_On) {
+#if !defined(_WIN32)
+		auto dictionary = make_shared<Dictionary>();
+		dictionary->load(options.dictionary_filename);
+		int thread_count = options.thread_count;
+		if (options.threads_mode == Threads_Mode::kNone || thread_count <= 0) {
+			thread_count = max(1, (int)thread::hardware_concurrency());
+		}
+		Solver_Server server(options, dictionary, thread_count);
+		server.serve(options.socket_path);
+		return 0;
+#else
+		cerr << "error: --serve needs Unix domain sockets" << endl;
+		exit(1);
+#endif
+	}
+	Word_Hunt_Solver solver_1(options);
+	if (options.batch_mode == Batch_Mode::k_Batch_Mode_On) solver_1.run_batch();
+	else solver_1.run();
+
+	return 0;
+}
@@ -0,0 +1,3138 @@
+// Word Hunt Solver (for GamePigeon iMessage Word Hunt Game)
+// Everything but the command line, in namespace word_hunt: the Dictionary,
+// the search engines (Word_Hunt_Core) and Solve_Context, which solves boards
+// in process without printing anything. Word_Hunt_Solver.cpp is the command
+// line program built on top of it, and the only place output is written
+// NOTES: Outside Windows the POSIX headers <fcntl.h>, <sys/mman.h>,
+// <sys/file.h>, <sys/stat.h> and <unistd.h> are included too (for mapping
+// dictionary images and locking --cache-file), so their names are visible
+// to every file that includes this one
+
+#ifndef WORD_HUNT_SOLVER_H
+#define WORD_HUNT_SOLVER_H
+
+#include <fstream>
+#include <string>
+#include <cassert>
+#include <vector>
+#include <cctype>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <chrono>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace word_hunt {
+
+// Exception classes
+class File_Not_Open{ /*...*/ };
+class Invalid_Dictionary{ /*...*/ };
+class Invalid_Edit{ /*...*/ };
+class Invalid_Board{ /*...*/ };
+
+// Option enumerated classes (the options of the search, see Core_Options)
+enum class Point_Output_Mode { kNone = 0, k_Point_Mode_On, };						 // -p
+enum class Alpha_Output_Mode { kNone = 0, k_Alpha_Mode_On, };					     // -a
+enum class Search_Depth_Output_Mode { kNone = 0, k_Search_Depth_Mode_On, };			 // -s
+enum class Linear_Search_Only_Mode { kNone = 0, k_Linear_Search_Mode_On, };			 // -l
+enum class Word_Hunt_Mode { kNone = 0, k_Word_Hunt_Mode_On, };						 // -w
+enum class Specify_Length_Mode { kNone = 0, k_Specify_Length_Mode_on, };			 // -x
+enum class Specify_First_Letter_Mode { kNone = 0, k_Specify_First_Letter_Mode_On, }; // -y
+enum class Engine_Mode { k_Trie_Engine = 0, k_Scan_Engine, k_Iterative_Engine, k_Linear_Engine, }; // -e
+enum class Dictionary_Mode { kNone = 0, k_Dictionary_Mode_On, };					 // -d
+enum class Threads_Mode { kNone = 0, k_Threads_Mode_On, };							 // -t
+enum class Unique_Mode { kNone = 0, k_Unique_Mode_On, };							 // -u
+enum class Scoring_Mode { k_Length_Scoring = 0, k_Word_Hunt_Scoring, };				 // --score
+enum class Top_Mode { kNone = 0, k_Top_Mode_On, };									 // --top
+enum class Stats_Mode { kNone = 0, k_Stats_Mode_On, };								 // --stats
+enum class Edit_Mode { kNone = 0, k_Edit_Mode_On, };								 // --edit
+enum class Cache_Mode { kNone = 0, k_Cache_Mode_On, };								 // --cache
+
+
+// Letter to write to (row, col) of a solved board (see
+// Word_Hunt_Core::apply_edits)
+struct Cell_Edit {
+	int row = 0;
+	int col = 0;
+	char letter = 0;
+};
+
+
+// Core Options struct
+// What Word_Hunt_Core searches for and how. Only the options of the search
+// itself: the command line program adds its own (output, input and modes)
+// in Word_Hunt_Solver.cpp, and Solve_Context makes these from Solve_Params
+struct Core_Options {
+	Point_Output_Mode point_output_mode = Point_Output_Mode::kNone;
+	Alpha_Output_Mode alpha_output_mode = Alpha_Output_Mode::kNone;
+	Search_Depth_Output_Mode search_depth_output_mode = Search_Depth_Output_Mode::kNone;
+	Linear_Search_Only_Mode linear_mode = Linear_Search_Only_Mode::kNone;
+	Word_Hunt_Mode word_hunt_mode = Word_Hunt_Mode::kNone;
+	Specify_Length_Mode specify_length_mode = Specify_Length_Mode::kNone;
+	Specify_First_Letter_Mode specify_first_letter_mode = Specify_First_Letter_Mode::kNone;
+	Engine_Mode engine_mode = Engine_Mode::k_Trie_Engine;
+	Dictionary_Mode dictionary_mode = Dictionary_Mode::kNone;
+	Threads_Mode threads_mode = Threads_Mode::kNone;
+	Unique_Mode unique_mode = Unique_Mode::kNone;
+	Scoring_Mode scoring_mode = Scoring_Mode::k_Length_Scoring;
+	Top_Mode top_mode = Top_Mode::kNone;
+	Stats_Mode stats_mode = Stats_Mode::kNone;
+	Edit_Mode edit_mode = Edit_Mode::kNone;
+	Cache_Mode cache_mode = Cache_Mode::kNone;
+
+	int search_depth = 6;					// Default Search Depth value is 6
+	std::string dictionary_filename = "Collins_Scrabble_Words_(2019).txt";
+	int specified_length = 0;
+	std::vector<char> specified_first_letters;
+	int thread_count = 1;					// 0 = one thread per core
+	int top_count = 0;
+	int cache_entries = 1024;				// Boards kept by --cache
+	std::string cache_filename;					// Empty = memory only
+};
+
+
+// EFFECTS: Returns number of set bits in x
+inline int popcount32(uint32_t x) {
+#if defined(__GNUC__)
+	return __builtin_popcount(x);
+#else
+	int count = 0;
+	while (x) { x &= x - 1; ++count; }
+	return count;
+#endif
+}
+
+// EFFECTS: Returns index of lowest set bit of x (x != 0)
+inline int count_trailing_zeros64(uint64_t x) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#else
+	int count = 0;
+	while ((x & 1) == 0) { x >>= 1; ++count; }
+	return count;
+#endif
+}
+
+
+// Direction struct
+// Note: a = NE, b = SE, c = SW, d = NW
+struct Direction {
+	int row;
+	int col;
+	char name;
+	const char* label;
+};
+// Same order look_recursive tries directions in. kDirections[(i + 4) % 8]
+// is the opposite of kDirections[i]
+constexpr Direction kDirections[8] = {
+	{ -1, 0, 'n', "N" }, { -1, 1, 'a', "NE" }, { 0, 1, 'e', "E" }, { 1, 1, 'b', "SE" },
+	{ 1, 0, 's', "S" }, { 1, -1, 'c', "SW" }, { 0, -1, 'w', "W" }, { -1, -1, 'd', "NW" },
+};
+
+
+// Fixed Board Geometry
+// Neighbor tables of a W x H board, computed at compile time. Used by
+// Word_Hunt_Core::fixed_recursive for the common GamePigeon sizes
+template <int W, int H>
+struct Fixed_Board_Geometry {
+	static constexpr int kCells = W * H;
+	static_assert(kCells <= 64, "Fixed boards use 64 bit cell masks");
+
+	std::array<std::array<int8_t, 8>, kCells> neighbor;	// Cell per direction, -1 if off board
+	std::array<uint64_t, kCells> mask;				// Bit n set if cell n is a neighbor
+
+	constexpr Fixed_Board_Geometry() : neighbor(), mask() {
+		for (int cell = 0; cell < kCells; ++cell) {
+			for (int i = 0; i < 8; ++i) {
+				int r = cell / W + kDirections[i].row;
+				int c = cell % W + kDirections[i].col;
+				if (r < 0 || r >= H || c < 0 || c >= W) {
+					neighbor[cell][i] = -1;
+					continue;
+				}
+				neighbor[cell][i] = (int8_t)(r * W + c);
+				mask[cell] |= uint64_t(1) << (r * W + c);
+			}
+		}
+	}
+};
+
+template <int W, int H>
+constexpr Fixed_Board_Geometry<W, H> kFixedGeometry{};
+
+
+// Dictionary
+// Word list plus a prefix trie of the word list, kept in one flat binary
+// image so it can either be built from the text word list or mapped straight
+// from a file written by --compile-dictionary.
+//
+// Trie nodes are stored in one contiguous array. Every node keeps a 26 bit
+// mask of its children, and the children themselves are stored next to each
+// other (in alphabetical order) starting at first_child. So the child for a
+// letter is found with a single popcount instead of a 26 entry table per node.
+//
+// Image layout (native byte order, every section 8 byte aligned):
+//   Image_Header
+//   Trie_Node[node_count]
+//   Letter_Histogram[word_count]	letter counts of each word
+//   uint32_t[kBucketCount + 1]	start of each bucket in bucket_ids
+//   uint32_t[word_count]		word ids grouped by bucket (see bucket)
+//   uint32_t[word_count + 1]	offsets of each word into the letter blob
+//   char[blob_size]			all words back to back, no separators
+class Dictionary {
+public:
+	static constexpr uint32_t kNoNode = 0xFFFFFFFF;
+	// Longest word that is put in the trie, so every path fits in a
+	// Found_Word's 64 bit packed path (21 steps of 3 bits)
+	static constexpr int kMaxWordLength = 22;
+	// Words are grouped in buckets by first letter (A-Z, then one bucket for
+	// anything else) and length (1 to kMaxWordLength, then one bucket for
+	// longer words)
+	static constexpr int kLetterBuckets = 27;
+	static constexpr int kLengthBuckets = kMaxWordLength + 2;
+	static constexpr int kBucketCount = kLetterBuckets * kLengthBuckets;
+	// Character that is never a child: it maps to bit 31 of child_mask, which
+	// is never set. Used as the border around the board (see clear_board)
+	static constexpr char kNoLetter = 'A' + 31;
+
+	struct Trie_Node {
+		uint32_t child_mask = 0;	// Bit i set if child for letter 'A' + i exists
+		uint32_t first_child = 0;	// Index of first child in nodes
+		int32_t word_id = -1;		// Index into word list if node ends a word
+	};
+
+	// Count of every letter A-Z of a word (or board), 4 bits per letter
+	// clamped to 7: letters A-P in lo, Q-Z in hi. The top bit of every nibble
+	// stays clear, so fits_in compares all 26 counts with one subtraction
+	struct Letter_Histogram {
+		uint64_t lo = 0;
+		uint64_t hi = 0;
+
+		// EFFECTS: Counts letter (anything but A-Z is ignored)
+		void add(char letter) {
+			if (letter < 'A' || letter > 'Z') return;
+			int index = letter - 'A';
+			uint64_t& half = index < 16 ? lo : hi;
+			int shift = 4 * (index & 15);
+			if ((half >> shift & 0xF) < 7) half += uint64_t(1) << shift;
+		}
+
+		// EFFECTS: Returns false if some letter is counted more often here than
+		// in board (so a word with this histogram can not be traced on board
+		// without reusing a cell)
+		// NOTES: Setting the top bit of every board nibble and subtracting
+		// leaves the top bit set exactly where board >= word, and no nibble
+		// ever borrows from the next one
+		bool fits_in(const Letter_Histogram& board) const {
+			const uint64_t kGuard = 0x8888888888888888ull;
+#if defined(__SSE2__)
+			__m128i guard = _mm_set1_epi64x((long long)kGuard);
+			__m128i word_counts = _mm_set_epi64x((long long)hi, (long long)lo);
+			__m128i board_counts = _mm_set_epi64x((long long)board.hi, (long long)board.lo);
+			__m128i difference = _mm_sub_epi64(_mm_or_si128(board_counts, guard), word_counts);
+			__m128i kept = _mm_cmpeq_epi8(_mm_and_si128(difference, guard), guard);
+			return _mm_movemask_epi8(kept) == 0xFFFF;
+#else
+			return (((board.lo | kGuard) - lo) & kGuard) == kGuard
+				&& (((board.hi | kGuard) - hi) & kGuard) == kGuard;
+#endif
+		}
+
+		// EFFECTS: Returns false if some letter counted here is not on board
+		// at all (so a word with this histogram can not be traced on board,
+		// even reusing cells)
+		bool letters_in(const Letter_Histogram& board) const {
+			return (any_letter(lo) & ~any_letter(board.lo)) == 0 && (any_letter(hi) & ~any_letter(board.hi)) == 0;
+		}
+
+	private:
+		// EFFECTS: Returns counts with the low bit of every nibble set if that
+		// count is not 0 and every other bit clear
+		static uint64_t any_letter(uint64_t counts) {
+			return (counts | counts >> 1 | counts >> 2) & 0x1111111111111111ull;
+		}
+	};
+
+	struct Image_Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t node_count;
+		uint32_t word_count;
+		uint32_t blob_size;
+		uint64_t nodes_offset;
+		uint64_t histograms_offset;
+		uint64_t bucket_starts_offset;
+		uint64_t bucket_ids_offset;
+		uint64_t offsets_offset;
+		uint64_t blob_offset;
+		uint64_t image_size;
+	};
+
+	Dictionary() = default;
+	Dictionary(const Dictionary&) = delete;
+	Dictionary& operator=(const Dictionary&) = delete;
+	~Dictionary() { unmap(); }
+
+	// EFFECTS: Loads filename, which is either a text word list or an image
+	// written by write_image (detected by its magic)
+	void load(const std::string& filename) {
+		if (is_image(filename)) load_image(filename);
+		else load_text(filename);
+	}
+
+	// EFFECTS: Reads text word list and builds image in memory
+	// Time Complexity: O(n log n)
+	void load_text(const std::string& filename) {
+		std::ifstream file;
+		file.open(filename);
+		// Throw exception if file is not open
+		File_Not_Open error1;
+		if (file.is_open() == false) throw error1;
+		std::vector<std::string> words;
+		std::string str_temp;
+		// Skip first line only if it is a header, a plain word list keeps
+		// its first word
+		std::getline(file, str_temp);
+		if (is_header(str_temp) == false) file.seekg(0);
+		while (file >> str_temp) {
+			words.push_back(str_temp);
+		}
+		file.close();
+		build(words);
+	}
+
+	// EFFECTS: Maps image written by write_image read-only. Nothing is
+	// parsed or copied, pages are shared with every other process using
+	// the same file
+	void load_image(const std::string& filename) {
+		unmap();
+		owned_image.clear();
+#if defined(_WIN32)
+		std::ifstream file(filename, std::ios::binary);
+		File_Not_Open error1;
+		if (file.is_open() == false) throw error1;
+		owned_image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		attach(owned_image.data(), owned_image.size());
+#else
+		int fd = open(filename.c_str(), O_RDONLY);
+		File_Not_Open error1;
+		if (fd < 0) throw error1;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Image_Header)) {
+			close(fd);
+			Invalid_Dictionary error2;
+			throw error2;
+		}
+		void* address = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (address == MAP_FAILED) throw error1;
+		mapped_address = address;
+		mapped_size = (size_t)st.st_size;
+		attach((const char*)address, mapped_size);
+#endif
+	}
+
+	// EFFECTS: Writes image to filename
+	void write_image(const std::string& filename) const {
+		std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+		File_Not_Open error1;
+		if (file.is_open() == false) throw error1;
+		file.write(image, (std::streamsize)header->image_size);
+	}
+
+	// EFFECTS: Returns child of node for letter, kNoNode if it does not exist
+	// (always the case for kNoLetter)
+	uint32_t child(uint32_t node, char letter) const {
+		uint32_t bit = 1u << ((letter - 'A') & 31);
+		const Trie_Node& n = nodes[node];
+		if ((n.child_mask & bit) == 0) return kNoNode;
+		return n.first_child + popcount32(n.child_mask & (bit - 1));
+	}
+
+	// EFFECTS: Returns word id of node, -1 if node does not end a word
+	int32_t word_id(uint32_t node) const { return nodes[node].word_id; }
+
+	// EFFECTS: Returns word with id
+	std::string_view word(uint32_t id) const {
+		return std::string_view(blob + offsets[id], offsets[id + 1] - offsets[id]);
+	}
+
+	// EFFECTS: Returns letter counts of word with id
+	const Letter_Histogram& histogram(uint32_t id) const { return histograms[id]; }
+
+	// EFFECTS: Returns range of ids (ascending) of words starting with letter
+	// (index into A-Z, 26 = anything else) that are length letters long
+	// (kMaxWordLength + 1 = any longer length)
+	std::pair<const uint32_t*, const uint32_t*> bucket(int letter, int length) const {
+		int b = letter * kLengthBuckets + length;
+		return { bucket_ids + bucket_starts[b], bucket_ids + bucket_starts[b + 1] };
+	}
+
+	uint32_t root(void) const { return 0; }
+	size_t node_count(void) const { return header ? header->node_count : 0; }
+	size_t size(void) const { return header ? header->word_count : 0; }
+
+	// EFFECTS: Returns 64 bit FNV-1a hash of the words (image header, word
+	// offsets and letters), which tells apart word lists of the same size
+	// Time Complexity: O(total letters)
+	uint64_t content_hash(void) const {
+		uint64_t hash = 14695981039346656037ull;
+		if (header == nullptr) return hash;
+		auto add = [&hash](const char* data, size_t size) {
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= (uint8_t)data[i];
+				hash *= 1099511628211ull;
+			}
+		};
+		add((const char*)header, sizeof(Image_Header));
+		add((const char*)offsets, ((size_t)header->word_count + 1) * sizeof(uint32_t));
+		add(blob, header->blob_size);
+		return hash;
+	}
+
+private:
+	static constexpr char kMagic[8] = { 'W', 'H', 'D', 'I', 'C', 'T', '\0', '\0' };
+	static constexpr uint32_t kVersion = 3;
+
+	// Views into the image (either owned_image or the mapped file)
+	const char* image = nullptr;
+	const Image_Header* header = nullptr;
+	const Trie_Node* nodes = nullptr;
+	const Letter_Histogram* histograms = nullptr;
+	const uint32_t* bucket_starts = nullptr;
+	const uint32_t* bucket_ids = nullptr;
+	const uint32_t* offsets = nullptr;
+	const char* blob = nullptr;
+
+	std::vector<char> owned_image;
+	void* mapped_address = nullptr;
+	size_t mapped_size = 0;
+
+	// EFFECTS: Returns offset rounded up to multiple of 8
+	static uint64_t align8(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+
+	// EFFECTS: Returns true if filename starts with image magic
+	static bool is_image(const std::string& filename) {
+		std::ifstream file(filename, std::ios::binary);
+		char magic[sizeof(kMagic)] = {};
+		if (!file.read(magic, sizeof(magic))) return false;
+		return std::equal(magic, magic + sizeof(magic), kMagic);
+	}
+
+	// EFFECTS: Returns true if line holds anything besides capital letters
+	// and whitespace (a title line rather than words)
+	static bool is_header(const std::string& line) {
+		for (char c : line) {
+			if ((c < 'A' || c > 'Z') && !std::isspace((unsigned char)c)) return true;
+		}
+		return false;
+	}
+
+	// EFFECTS: Returns bucket index of word
+	static int bucket_of(const std::string& word) {
+		int letter = word[0] >= 'A' && word[0] <= 'Z' ? word[0] - 'A' : kLetterBuckets - 1;
+		int length = (int)std::min(word.length(), (size_t)kMaxWordLength + 1);
+		return letter * kLengthBuckets + length;
+	}
+
+	// EFFECTS: Returns true if word is non-empty, not longer than
+	// kMaxWordLength and only has letters A-Z
+	static bool is_valid_word(const std::string& word) {
+		if (word.empty() || word.length() > (size_t)kMaxWordLength) return false;
+		for (char c : word) {
+			if (c < 'A' || c > 'Z') return false;
+		}
+		return true;
+	}
+
+	// EFFECTS: Builds image out of words. word_id of a trie node is the
+	// index of the word in words. Words that are not all capital letters
+	// are kept in the word list but left out of the trie
+	void build(const std::vector<std::string>& words) {
+		std::vector<Trie_Node> trie = build_trie(words);
+		uint64_t blob_size = 0;
+		for (const auto& word : words) blob_size += word.length();
+
+		Image_Header h = {};
+		std::copy(kMagic, kMagic + sizeof(kMagic), h.magic);
+		h.version = kVersion;
+		h.node_count = (uint32_t)trie.size();
+		h.word_count = (uint32_t)words.size();
+		h.blob_size = (uint32_t)blob_size;
+		h.nodes_offset = align8(sizeof(Image_Header));
+		h.histograms_offset = align8(h.nodes_offset + trie.size() * sizeof(Trie_Node));
+		h.bucket_starts_offset = align8(h.histograms_offset + words.size() * sizeof(Letter_Histogram));
+		h.bucket_ids_offset = align8(h.bucket_starts_offset + (kBucketCount + 1) * sizeof(uint32_t));
+		h.offsets_offset = align8(h.bucket_ids_offset + words.size() * sizeof(uint32_t));
+		h.blob_offset = align8(h.offsets_offset + (words.size() + 1) * sizeof(uint32_t));
+		h.image_size = h.blob_offset + blob_size;
+
+		unmap();
+		owned_image.assign((size_t)h.image_size, '\0');
+		char* out = owned_image.data();
+		std::memcpy(out, &h, sizeof(h));
+		std::memcpy(out + h.nodes_offset, trie.data(), trie.size() * sizeof(Trie_Node));
+		Letter_Histogram* out_histograms = (Letter_Histogram*)(out + h.histograms_offset);
+		for (size_t i = 0; i < words.size(); ++i) {
+			Letter_Histogram histogram;
+			for (char letter : words[i]) histogram.add(letter);
+			out_histograms[i] = histogram;
+		}
+		// Counting sort of ids by bucket, so every bucket stays in id order
+		uint32_t* out_bucket_starts = (uint32_t*)(out + h.bucket_starts_offset);
+		uint32_t* out_bucket_ids = (uint32_t*)(out + h.bucket_ids_offset);
+		for (const auto& word : words) ++out_bucket_starts[bucket_of(word) + 1];
+		for (int b = 0; b < kBucketCount; ++b) out_bucket_starts[b + 1] += out_bucket_starts[b];
+		std::vector<uint32_t> next(out_bucket_starts, out_bucket_starts + kBucketCount);
+		for (size_t i = 0; i < words.size(); ++i) out_bucket_ids[next[bucket_of(words[i])]++] = (uint32_t)i;
+		uint32_t* out_offsets = (uint32_t*)(out + h.offsets_offset);
+		char* out_blob = out + h.blob_offset;
+		uint32_t offset = 0;
+		for (size_t i = 0; i < words.size(); ++i) {
+			out_offsets[i] = offset;
+			std::memcpy(out_blob + offset, words[i].data(), words[i].length());
+			offset += (uint32_t)words[i].length();
+		}
+		out_offsets[words.size()] = offset;
+		attach(owned_image.data(), owned_image.size());
+	}
+
+	// EFFECTS: Returns trie nodes for words
+	// Time Complexity: O(n log n) (sorting) + O(total letters)
+	static std::vector<Trie_Node> build_trie(const std::vector<std::string>& words) {
+		std::vector<Trie_Node> trie;
+		std::vector<int32_t> ids;
+		ids.reserve(words.size());
+		for (size_t i = 0; i < words.size(); ++i) {
+			if (is_valid_word(words[i])) ids.push_back((int32_t)i);
+		}
+		std::stable_sort(ids.begin(), ids.end(), [&words](int32_t a, int32_t b) {
+			return words[a] < words[b];
+		});
+
+		// Breadth first construction so that children of a node are contiguous
+		// pending[i] = range of ids (in sorted order) that pass through trie[i]
+		struct Pending { size_t lo; size_t hi; size_t depth; };
+		std::vector<Pending> pending;
+		trie.emplace_back();
+		pending.push_back({ 0, ids.size(), 0 });
+		for (size_t current = 0; current < trie.size(); ++current) {
+			Pending p = pending[current];
+			// Shortest word sorts first, so a word ending here is at ids[lo]
+			// (duplicate words keep the first id)
+			while (p.lo < p.hi && words[ids[p.lo]].length() == p.depth) {
+				if (trie[current].word_id < 0) trie[current].word_id = ids[p.lo];
+				++p.lo;
+			}
+			trie[current].first_child = (uint32_t)trie.size();
+			size_t lo = p.lo;
+			while (lo < p.hi) {
+				char letter = words[ids[lo]][p.depth];
+				size_t hi = lo + 1;
+				while (hi < p.hi && words[ids[hi]][p.depth] == letter) ++hi;
+				trie[current].child_mask |= 1u << (letter - 'A');
+				trie.emplace_back();
+				pending.push_back({ lo, hi, p.depth + 1 });
+				lo = hi;
+			}
+		}
+		return trie;
+	}
+
+	// EFFECTS: Points views at image of size bytes
+	// Throws Invalid_Dictionary if the image is truncated or from another version
+	void attach(const char* data, size_t size) {
+		Invalid_Dictionary error;
+		if (size < sizeof(Image_Header)) throw error;
+		const Image_Header* h = (const Image_Header*)data;
+		if (std::equal(h->magic, h->magic + sizeof(kMagic), kMagic) == false) throw error;
+		if (h->version != kVersion || h->image_size > size) throw error;
+		if (h->nodes_offset + (uint64_t)h->node_count * sizeof(Trie_Node) > h->histograms_offset) throw error;
+		if (h->histograms_offset + (uint64_t)h->word_count * sizeof(Letter_Histogram) > h->bucket_starts_offset) throw error;
+		if (h->bucket_starts_offset + (kBucketCount + 1) * sizeof(uint32_t) > h->bucket_ids_offset) throw error;
+		if (h->bucket_ids_offset + (uint64_t)h->word_count * sizeof(uint32_t) > h->offsets_offset) throw error;
+		const uint32_t* starts = (const uint32_t*)(data + h->bucket_starts_offset);
+		if (starts[kBucketCount] != h->word_count) throw error;
+		if (h->offsets_offset + ((uint64_t)h->word_count + 1) * sizeof(uint32_t) > h->blob_offset) throw error;
+		if (h->blob_offset + h->blob_size > h->image_size || h->node_count == 0) throw error;
+		image = data;
+		header = h;
+		nodes = (const Trie_Node*)(data + h->nodes_offset);
+		histograms = (const Letter_Histogram*)(data + h->histograms_offset);
+		bucket_starts = starts;
+		bucket_ids = (const uint32_t*)(data + h->bucket_ids_offset);
+		offsets = (const uint32_t*)(data + h->offsets_offset);
+		blob = data + h->blob_offset;
+	}
+
+	// EFFECTS: Releases mapped file, if any
+	void unmap(void) {
+#if !defined(_WIN32)
+		if (mapped_address != nullptr) munmap(mapped_address, mapped_size);
+#endif
+		mapped_address = nullptr;
+		mapped_size = 0;
+		image = nullptr;
+		header = nullptr;
+	}
+};
+
+
+// Line Automaton Class
+// Aho-Corasick automaton over the nodes of a Dictionary trie, which finds
+// every word in a line of letters in one pass. The trie is the goto
+// function. Failure and output links are worked out the first time a node is
+// reached and kept for every later line and board, so only the part of the
+// trie that boards actually reach is ever linked
+// NOTES: Not thread safe, next() fills in links
+class Line_Automaton {
+public:
+	explicit Line_Automaton(std::shared_ptr<const Dictionary> dictionary_in)
+		: dictionary(std::move(dictionary_in)),
+		fail(dictionary->node_count(), Dictionary::kNoNode),
+		output(dictionary->node_count(), Dictionary::kNoNode) {
+		fail[dictionary->root()] = dictionary->root();
+	}
+
+	// EFFECTS: Returns state after reading letter in state (root if no
+	// word has a prefix ending in letter)
+	uint32_t next(uint32_t state, char letter) {
+		uint32_t root = dictionary->root();
+		while (true) {
+			uint32_t child = dictionary->child(state, letter);
+			if (child != Dictionary::kNoNode) {
+				if (fail[child] == Dictionary::kNoNode) link(child, state, letter);
+				return child;
+			}
+			if (state == root) return root;
+			state = fail[state];
+		}
+	}
+
+	// EFFECTS: Returns the next node on the failure chain of state that ends
+	// a word (a shorter word ending at the same letter), kNoNode if none
+	uint32_t next_output(uint32_t state) const { return output[state]; }
+
+private:
+	std::shared_ptr<const Dictionary> dictionary;
+	std::vector<uint32_t> fail;		// Longest proper suffix of node that is a trie node, kNoNode = not linked yet
+	std::vector<uint32_t> output;	// See next_output
+
+	// EFFECTS: Links node, the child of parent for letter
+	// NOTES: Parent is linked already, and so is every node on its failure
+	// chain, which is all next() needs
+	void link(uint32_t node, uint32_t parent, char letter) {
+		uint32_t root = dictionary->root();
+		uint32_t target = parent == root ? root : next(fail[parent], letter);
+		fail[node] = target;
+		output[node] = dictionary->word_id(target) >= 0 ? target : output[target];
+	}
+};
+
+
+// Score Table
+// Points a found word is worth. Points only depend on the word's length, so
+// every scoring rule is a table filled once and looked up while searching
+class Score_Table {
+public:
+	// EFFECTS: Returns table where points = length (the original -p order)
+	static Score_Table by_length(void) {
+		Score_Table table;
+		for (int length = 0; length <= Dictionary::kMaxWordLength; ++length) table.points[length] = length;
+		return table;
+	}
+
+	// EFFECTS: Returns GamePigeon Word Hunt table: 3 letters = 100,
+	// 4 = 400, 5 = 800, 6 = 1400 and 400 more per extra letter
+	// (shorter words are not allowed in the game)
+	static Score_Table word_hunt(void) {
+		Score_Table table;
+		table.points[3] = 100;
+		table.points[4] = 400;
+		table.points[5] = 800;
+		for (int length = 6; length <= Dictionary::kMaxWordLength; ++length) {
+			table.points[length] = 1400 + 400 * (length - 6);
+		}
+		return table;
+	}
+
+	uint32_t operator()(int length) const { return points[length]; }
+	uint32_t max_points(void) const { return points[Dictionary::kMaxWordLength]; }
+
+private:
+	std::array<uint32_t, Dictionary::kMaxWordLength + 1> points = {};
+};
+
+
+// Words (dictionary ids, ascending) that an edit made findable or no longer
+// findable, after -w, -l and the other filters (see apply_edits)
+struct Board_Diff {
+	std::vector<uint32_t> added;
+	std::vector<uint32_t> removed;
+};
+
+
+// Search Stats
+// What one thread's searches did (--stats). Every search function takes a
+// kStats template flag and only touches these when it is set, so the
+// counting code is compiled out of normal runs. Each worker thread has its
+// own copy (cache line aligned so threads never share a line)
+struct alignas(64) Search_Stats {
+	uint64_t nodes = 0;					// Search calls
+	uint64_t pruned_bounds = 0;			// Stepped off the board
+	uint64_t pruned_depth = 0;			// Hit search depth (or -x length)
+	uint64_t pruned_letter = 0;			// Letter does not continue any word
+	uint64_t pruned_revisit = 0;		// Cell already on the path (Word Hunt)
+	uint64_t matches = 0;				// Words found
+	uint64_t rejected_word_hunt = 0;	// Found words that revisit a cell
+
+	Search_Stats& operator+=(const Search_Stats& other) {
+		nodes += other.nodes;
+		pruned_bounds += other.pruned_bounds;
+		pruned_depth += other.pruned_depth;
+		pruned_letter += other.pruned_letter;
+		pruned_revisit += other.pruned_revisit;
+		matches += other.matches;
+		rejected_word_hunt += other.rejected_word_hunt;
+		return *this;
+	}
+};
+
+
+// Arena
+// Append only storage for the trivially copyable records of one solve.
+// Records live in fixed size blocks that are never moved or freed, so growing
+// never copies earlier records, and reset() hands the same memory to the next
+// board.
+template <class T>
+class Arena {
+	static_assert(std::is_trivially_copyable<T>::value, "Arena only holds plain records");
+
+public:
+	// EFFECTS: Appends value
+	void push_back(const T& value) {
+		if ((count >> kBlockBits) == blocks.size()) blocks.emplace_back(new T[kBlockSize]);
+		blocks[count >> kBlockBits][count & (kBlockSize - 1)] = value;
+		++count;
+	}
+
+	const T& operator[](size_t i) const { return blocks[i >> kBlockBits][i & (kBlockSize - 1)]; }
+	size_t size(void) const { return count; }
+	bool empty(void) const { return count == 0; }
+
+	// EFFECTS: Forgets every record, keeping the blocks
+	void reset(void) { count = 0; }
+
+private:
+	static constexpr size_t kBlockBits = 12;
+	static constexpr size_t kBlockSize = size_t(1) << kBlockBits;
+
+	std::vector<std::unique_ptr<T[]>> blocks;
+	size_t count = 0;
+};
+
+
+// Work Stealing Pool
+// Runs fixed sets of independent tasks on several threads. The threads are
+// started once and wait between runs, so a solver keeps the same workers
+// from board to board. Every worker starts with its own contiguous block of
+// tasks and takes from the back of its own queue. Once it runs dry it steals
+// from the front of another worker's queue, so one expensive task (e.g. a
+// start cell in a dense corner of the board) does not leave the other
+// threads idle. The queues are only locked once per task, never inside a task.
+class Work_Stealing_Pool {
+public:
+	// EFFECTS: Starts thread_count - 1 workers (the thread calling run is
+	// worker 0)
+	explicit Work_Stealing_Pool(int thread_count_in)
+		: thread_count(std::max(1, thread_count_in)), queues(thread_count) {
+		for (int worker = 1; worker < thread_count; ++worker) threads.emplace_back(&Work_Stealing_Pool::work, this, worker);
+	}
+	Work_Stealing_Pool(const Work_Stealing_Pool&) = delete;
+	Work_Stealing_Pool& operator=(const Work_Stealing_Pool&) = delete;
+
+	// EFFECTS: Stops and joins every worker
+	~Work_Stealing_Pool() {
+		{
+			std::lock_guard<std::mutex> guard(state_lock);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& t : threads) t.join();
+	}
+
+	int size(void) const { return thread_count; }
+
+	// EFFECTS: Runs task(i, worker) for every i in [0, task_count) on every
+	// worker and returns once every task is done
+	void run(size_t task_count, const std::function<void(size_t, int)>& task) {
+		for (int worker = 0; worker < thread_count; ++worker) {
+			size_t lo = task_count * worker / thread_count;
+			size_t hi = task_count * (worker + 1) / thread_count;
+			std::lock_guard<std::mutex> guard(queues[worker].lock);
+			queues[worker].tasks.clear();
+			queues[worker].front = 0;
+			for (size_t i = hi; i > lo; --i) queues[worker].tasks.push_back(i - 1);
+		}
+		{
+			std::lock_guard<std::mutex> guard(state_lock);
+			current_task = &task;
+			busy = thread_count - 1;
+			++generation;
+		}
+		wake.notify_all();
+		drain(0, task);
+		std::unique_lock<std::mutex> guard(state_lock);
+		done.wait(guard, [this] { return busy == 0; });
+		current_task = nullptr;
+	}
+
+private:
+	// Tasks left are tasks[front] to tasks.back(). Kept as a vector, so
+	// its memory is reused by the next run
+	struct Task_Queue {
+		std::mutex lock;
+		std::vector<size_t> tasks;
+		size_t front = 0;
+	};
+
+	int thread_count;
+	std::vector<Task_Queue> queues;
+	std::vector<std::thread> threads;
+	// Guards everything below. generation is bumped by every run, busy is
+	// the number of workers (besides worker 0) still working on it
+	std::mutex state_lock;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const std::function<void(size_t, int)>* current_task = nullptr;
+	uint64_t generation = 0;
+	int busy = 0;
+	bool stopping = false;
+
+	// EFFECTS: Body of worker thread, runs tasks of every run until the
+	// pool is destroyed
+	void work(int worker) {
+		uint64_t seen = 0;
+		while (true) {
+			const std::function<void(size_t, int)>* task;
+			{
+				std::unique_lock<std::mutex> guard(state_lock);
+				wake.wait(guard, [&] { return stopping || generation != seen; });
+				if (stopping) return;
+				seen = generation;
+				task = current_task;
+			}
+			drain(worker, *task);
+			std::lock_guard<std::mutex> guard(state_lock);
+			if (--busy == 0) done.notify_one();
+		}
+	}
+
+	// EFFECTS: Runs tasks on worker until every queue is empty
+	void drain(int worker, const std::function<void(size_t, int)>& task) {
+		size_t i;
+		while (take(worker, i)) task(i, worker);
+	}
+
+	// EFFECTS: Takes next task for worker, stealing if its own queue is empty
+	// Returns false once every queue is empty
+	bool take(int worker, size_t& i) {
+		{
+			std::lock_guard<std::mutex> guard(queues[worker].lock);
+			Task_Queue& own = queues[worker];
+			if (own.tasks.size() > own.front) {
+				i = own.tasks.back();
+				own.tasks.pop_back();
+				return true;
+			}
+		}
+		for (int offset = 1; offset < thread_count; ++offset) {
+			Task_Queue& victim = queues[(worker + offset) % thread_count];
+			std::lock_guard<std::mutex> guard(victim.lock);
+			if (victim.tasks.size() > victim.front) {
+				i = victim.tasks[victim.front++];
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+
+// Board Cache Class
+// Matches of boards solved before, so a board that comes back (shared
+// boards, retries) is answered without searching. Turning or flipping a
+// board moves every path along with the letters, so a board is stored once
+// under its canonical form: the smallest of its 8 turns and flips (rows and
+// cols, then the letters row major). Keeps up to capacity boards, dropping
+// the least recently used one, and can also append every new board to a file
+// that later runs (with the same signature) start from. The file is
+// rewritten with only the boards kept once it holds kCompactFactor times
+// as many, so it stays a few times the size of the cache
+//
+// File format (all integers little endian):
+//   Header: "WHCACHE" 0, uint32 version, uint32 signature length, signature
+//   Record: uint16 rows, uint16 cols, uint32 match count, the canonical
+//           letters (rows * cols bytes), then per match uint32 word id,
+//           uint16 row, uint16 col, uint8 length, uint8 Word Hunt valid and
+//           uint64 packed path (see Word_Hunt_Core::Found_Word)
+// NOTES: Thread safe. Solvers in one process that use the same file get one
+// shared cache (see shared), and processes that use the same file take turns
+// through a lock file (see File_Lock), so the file is never read while it is
+// being rewritten
+class Board_Cache {
+public:
+	// Found word without its points, which only depend on its length
+	struct Match {
+		uint32_t word_id = 0;
+		uint16_t row = 0;
+		uint16_t col = 0;
+		uint8_t length = 0;
+		bool word_hunt_valid = false;
+		uint64_t path = 0;
+	};
+
+	// signature tells apart files written with settings that find other
+	// matches (dictionary, -s, -w, ...), and word_count is the number of
+	// words in that dictionary (word ids read from the file must be below it)
+	Board_Cache(size_t capacity_in, const std::string& filename_in, const std::string& signature_in, uint32_t word_count_in)
+		: capacity(std::max<size_t>(capacity_in, 1)), filename(filename_in), signature(signature_in), word_count(word_count_in) {
+		if (filename.empty() == false) load_file();
+	}
+
+	// EFFECTS: Returns the cache for these settings. While one caller keeps
+	// it, every caller with the same file and settings gets the same cache,
+	// so the file is loaded once and solvers on other threads find the boards
+	// each other solved. A cache without a file is never shared
+	static std::shared_ptr<Board_Cache> shared(size_t capacity, const std::string& filename, const std::string& signature, uint32_t word_count) {
+		if (filename.empty()) return std::make_shared<Board_Cache>(capacity, filename, signature, word_count);
+		static std::mutex open_lock;
+		static std::unordered_map<std::string, std::weak_ptr<Board_Cache>> open_caches;
+		std::string settings = std::to_string(capacity) + '\0' + filename + '\0' + signature;
+		std::lock_guard<std::mutex> guard(open_lock);
+		for (auto it = open_caches.begin(); it != open_caches.end();) {
+			if (it->second.expired()) it = open_caches.erase(it);
+			else ++it;
+		}
+		std::shared_ptr<Board_Cache> cache = open_caches[settings].lock();
+		if (cache == nullptr) {
+			cache = std::make_shared<Board_Cache>(capacity, filename, signature, word_count);
+			open_caches[settings] = cache;
+		}
+		return cache;
+	}
+
+	// EFFECTS: Sets key to the canonical form of the rows x cols board
+	// letters (row major) and returns the symmetry that turns letters into it
+	// scratch is overwritten (passed in so its memory can be reused)
+	static int canonical(std::string_view letters, int rows, int cols, std::string& key, std::string& scratch) {
+		int best = 0;
+		for (int symmetry = 0; symmetry < 8; ++symmetry) {
+			transformed_key(letters, rows, cols, symmetry, scratch);
+			if (symmetry == 0 || scratch < key) {
+				key.swap(scratch);
+				best = symmetry;
+			}
+		}
+		return best;
+	}
+
+	// EFFECTS: Sets matches to the ones stored under key (marking it most
+	// recently used). Returns false if there are none
+	bool find(const std::string& key, std::vector<Match>& matches) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto it = index.find(key);
+		if (it == index.end()) return false;
+		entries.splice(entries.begin(), entries, it->second);
+		matches = it->second->matches;
+		return true;
+	}
+
+	// EFFECTS: Stores matches under key, and appends them to the file
+	// unless another solver sharing the cache stored the board first. Once
+	// the file holds kCompactFactor times more boards than the cache keeps,
+	// it is rewritten with the boards kept instead (see compact_file)
+	void insert(const std::string& key, std::vector<Match> matches) {
+		std::string bytes;
+		bool compact = false;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (index.count(key) != 0) return;
+			if (filename.empty() == false) {
+				bytes = record(key, matches);
+				compact = ++file_records > capacity * kCompactFactor;
+			}
+			insert_entry(key, std::move(matches));
+		}
+		if (compact) compact_file();
+		else if (bytes.empty() == false) append_file(bytes);
+	}
+
+	// EFFECTS: Returns match moved by symmetry from a rows x cols board
+	static Match transform(const Match& match, int symmetry, int rows, int cols) {
+		const Symmetry& t = kSymmetries[symmetry];
+		Match moved = match;
+		moved.row = (uint16_t)t.row(match.row, match.col, rows, cols);
+		moved.col = (uint16_t)t.col(match.row, match.col, rows, cols);
+		moved.path = 0;
+		for (int i = 0; i < match.length - 1; ++i) {
+			int step = (int)(match.path >> (3 * (match.length - 2 - i)) & 7);
+			moved.path = moved.path << 3 | direction_map()[symmetry][step];
+		}
+		return moved;
+	}
+
+	// EFFECTS: Returns symmetry that undoes symmetry
+	static int inverse(int symmetry) {
+		const Symmetry& t = kSymmetries[symmetry];
+		for (int other = 0; other < 8; ++other) {
+			const Symmetry& u = kSymmetries[other];
+			if (u.a * t.a + u.b * t.c == 1 && u.a * t.b + u.b * t.d == 0
+				&& u.c * t.a + u.d * t.c == 0 && u.c * t.b + u.d * t.d == 1) return other;
+		}
+		return 0;
+	}
+
+	// EFFECTS: Returns true if symmetry swaps rows and cols
+	static bool transposes(int symmetry) { return kSymmetries[symmetry].a == 0; }
+
+private:
+	// Symmetry
+	// Cell (row, col) goes to (a * row + b * col, c * row + d * col), moved
+	// back onto the board: identity, turns by 90, 180 and 270 degrees,
+	// mirror left-right, mirror top-bottom and the two diagonal mirrors
+	struct Symmetry {
+		int a, b, c, d;
+
+		int row(int r, int c_in, int rows, int cols) const {
+			return a * r + b * c_in + (a < 0 ? rows - 1 : 0) + (b < 0 ? cols - 1 : 0);
+		}
+		int col(int r, int c_in, int rows, int cols) const {
+			return c * r + d * c_in + (c < 0 ? rows - 1 : 0) + (d < 0 ? cols - 1 : 0);
+		}
+	};
+	static constexpr Symmetry kSymmetries[8] = {
+		{ 1, 0, 0, 1 }, { 0, 1, -1, 0 }, { -1, 0, 0, -1 }, { 0, -1, 1, 0 },
+		{ 1, 0, 0, -1 }, { -1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, -1, -1, 0 },
+	};
+	static constexpr uint32_t kVersion = 1;
+	static constexpr size_t kCompactFactor = 2;
+
+	struct Entry {
+		std::string key;
+		std::vector<Match> matches;
+	};
+
+	// File Lock
+	// Holds a lock on filename + ".lock" while alive: shared while appending
+	// (every record is one write(2), see append_file), exclusive while
+	// loading and rewriting the file. The lock file outlives renames of the
+	// cache file, which the lock must not depend on
+	// NOTES: Does nothing on Windows
+	class File_Lock {
+	public:
+		File_Lock(const std::string& filename, bool exclusive) {
+#if !defined(_WIN32)
+			fd = open((filename + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+			// Without a lock file (e.g. a read only directory) go on unlocked
+			while (fd >= 0 && flock(fd, exclusive ? LOCK_EX : LOCK_SH) != 0 && errno == EINTR) {}
+#else
+			(void)filename;
+			(void)exclusive;
+#endif
+		}
+		~File_Lock() {
+#if !defined(_WIN32)
+			if (fd >= 0) close(fd);
+#endif
+		}
+		File_Lock(const File_Lock&) = delete;
+		File_Lock& operator=(const File_Lock&) = delete;
+
+	private:
+		int fd = -1;
+	};
+
+	size_t capacity;
+	std::string filename;
+	std::string signature;
+	uint32_t word_count;
+	std::mutex lock;			// Guards entries, index and file_records
+	std::list<Entry> entries;	// Most recently used first
+	std::unordered_map<std::string, std::list<Entry>::iterator> index;
+	size_t file_records = 0;	// Boards in the file, as far as this cache knows
+
+	// EFFECTS: Returns table of where every kDirections index goes under
+	// every symmetry
+	static const std::array<std::array<uint8_t, 8>, 8>& direction_map(void) {
+		static const std::array<std::array<uint8_t, 8>, 8> table = [] {
+			std::array<std::array<uint8_t, 8>, 8> result = {};
+			for (int symmetry = 0; symmetry < 8; ++symmetry) {
+				const Symmetry& t = kSymmetries[symmetry];
+				for (int i = 0; i < 8; ++i) {
+					int row = t.a * kDirections[i].row + t.b * kDirections[i].col;
+					int col = t.c * kDirections[i].row + t.d * kDirections[i].col;
+					for (int j = 0; j < 8; ++j) {
+						if (kDirections[j].row == row && kDirections[j].col == col) result[symmetry][i] = (uint8_t)j;
+					}
+				}
+			}
+			return result;
+		}();
+		return table;
+	}
+
+	// EFFECTS: Sets key to the rows x cols board letters moved by symmetry:
+	// its rows and cols (uint16 little endian) then its letters row major
+	static void transformed_key(std::string_view letters, int rows, int cols, int symmetry, std::string& key) {
+		const Symmetry& t = kSymmetries[symmetry];
+		int new_rows = transposes(symmetry) ? cols : rows;
+		int new_cols = transposes(symmetry) ? rows : cols;
+		key.assign(4 + letters.size(), 0);
+		key[0] = (char)(new_rows & 0xFF);
+		key[1] = (char)(new_rows >> 8);
+		key[2] = (char)(new_cols & 0xFF);
+		key[3] = (char)(new_cols >> 8);
+		for (int r = 0; r < rows; ++r) {
+			for (int c = 0; c < cols; ++c) {
+				key[4 + t.row(r, c, rows, cols) * new_cols + t.col(r, c, rows, cols)] = letters[r * cols + c];
+			}
+		}
+	}
+
+	// EFFECTS: Stores matches under key, dropping the least recently used
+	// board if the cache is full
+	void insert_entry(const std::string& key, std::vector<Match> matches) {
+		auto it = index.find(key);
+		if (it != index.end()) {
+			entries.erase(it->second);
+			index.erase(it);
+		}
+		entries.push_front(Entry{ key, std::move(matches) });
+		index[key] = entries.begin();
+		if (entries.size() > capacity) {
+			index.erase(entries.back().key);
+			entries.pop_back();
+		}
+	}
+
+	// EFFECTS: Returns file header
+	std::string file_header(void) const {
+		std::string header("WHCACHE", 8);
+		put_u32(header, kVersion);
+		put_u32(header, (uint32_t)signature.size());
+		header += signature;
+		return header;
+	}
+
+	// EFFECTS: Returns record of matches stored under key
+	static std::string record(const std::string& key, const std::vector<Match>& matches) {
+		std::string bytes;
+		bytes.reserve(key.size() + 4 + matches.size() * 18);
+		bytes.append(key, 0, 4);
+		put_u32(bytes, (uint32_t)matches.size());
+		bytes.append(key, 4, std::string::npos);
+		for (const auto& match : matches) {
+			put_u32(bytes, match.word_id);
+			put_u16(bytes, match.row);
+			put_u16(bytes, match.col);
+			bytes += (char)match.length;
+			bytes += (char)(match.word_hunt_valid ? 1 : 0);
+			put_u32(bytes, (uint32_t)match.path);
+			put_u32(bytes, (uint32_t)(match.path >> 32));
+		}
+		return bytes;
+	}
+
+	// EFFECTS: Loads every record of the file into the cache. A file with
+	// another signature (or that is not a cache file) is started over, and a
+	// file holding more boards than the cache is rewritten with the ones kept
+	// NOTES: Holds the exclusive file lock throughout, so no other process appends
+	// to or rewrites the file in between
+	void load_file(void) {
+		File_Lock file_lock(filename, true);
+		std::string bytes;
+		if (read_file(bytes) == false) {
+			rewrite_file();
+			return;
+		}
+		size_t records = 0;
+		size_t end = read_records(bytes, records, [this](const std::string& key, std::vector<Match>& matches) {
+			insert_entry(key, std::move(matches));
+		});
+		if (records > entries.size() || end != bytes.size()) rewrite_file();
+		file_records = entries.size();
+	}
+
+	// EFFECTS: Rewrites the file with the boards in the cache. Boards other
+	// processes appended that this cache does not have are kept as well, as
+	// the least recently used ones, while there is room
+	// NOTES: Holds the exclusive file lock (so nobody appends in between),
+	// then lock
+	void compact_file(void) {
+		File_Lock file_lock(filename, true);
+		std::lock_guard<std::mutex> guard(lock);
+		std::string bytes;
+		if (read_file(bytes)) {
+			std::vector<Entry> others;
+			size_t records = 0;
+			read_records(bytes, records, [&](const std::string& key, std::vector<Match>& matches) {
+				if (index.count(key) == 0) others.push_back(Entry{ key, std::move(matches) });
+			});
+			// Newest (last in the file) first, so the oldest go if full
+			for (auto it = others.rbegin(); it != others.rend() && entries.size() < capacity; ++it) {
+				if (index.count(it->key) != 0) continue;
+				entries.push_back(std::move(*it));
+				index[entries.back().key] = std::prev(entries.end());
+			}
+		}
+		rewrite_file();
+		file_records = entries.size();
+	}
+
+	// EFFECTS: Sets bytes to the whole file. Returns false unless it starts
+	// with file_header (e.g. it is missing or has another signature)
+	bool read_file(std::string& bytes) const {
+		std::ifstream file(filename, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		std::string header = file_header();
+		return bytes.compare(0, header.size(), header) == 0;
+	}
+
+	// EFFECTS: Calls visit(key, matches) for every whole record of bytes (a
+	// file read by read_file) in file order and adds their number to
+	// records. Returns the offset after the last whole record
+	// NOTES: Stops at the first record that is cut short or that no solver
+	// could have written (see match_valid), e.g. after a short append, so
+	// the rest of the file is dropped
+	template <class Visit>
+	size_t read_records(const std::string& bytes, size_t& records, Visit visit) const {
+		size_t at = file_header().size();
+		std::vector<Match> matches;
+		while (at + 8 <= bytes.size()) {
+			int rows = get_u16(bytes, at);
+			int cols = get_u16(bytes, at + 2);
+			uint32_t count = get_u32(bytes, at + 4);
+			if (rows == 0 || cols == 0) break;
+			size_t letters = (size_t)rows * cols;
+			size_t size = 8 + letters + (size_t)count * 18;
+			// Cut short (e.g. the program stopped while appending)
+			if (at + size > bytes.size()) break;
+			std::string key = bytes.substr(at, 4) + bytes.substr(at + 8, letters);
+			if (std::any_of(key.begin() + 4, key.end(), [](char letter) { return letter < 'A' || letter > 'Z'; })) break;
+			matches.assign(count, Match());
+			size_t m = at + 8 + letters;
+			bool valid = true;
+			for (auto& match : matches) {
+				match.word_id = get_u32(bytes, m);
+				match.row = get_u16(bytes, m + 4);
+				match.col = get_u16(bytes, m + 6);
+				match.length = (uint8_t)bytes[m + 8];
+				match.word_hunt_valid = bytes[m + 9] != 0;
+				match.path = get_u32(bytes, m + 10) | (uint64_t)get_u32(bytes, m + 14) << 32;
+				m += 18;
+				if (match_valid(match, rows, cols) == false) {
+					valid = false;
+					break;
+				}
+			}
+			if (valid == false) break;
+			visit(key, matches);
+			at += size;
+			++records;
+		}
+		return at;
+	}
+
+	// EFFECTS: Returns true if match can be a match on a rows x cols board:
+	// a word of the dictionary, at most Dictionary::kMaxWordLength letters
+	// long, starting on the board and with every step of its path staying on
+	// it (and no path bits past its last step)
+	bool match_valid(const Match& match, int rows, int cols) const {
+		if (match.word_id >= word_count) return false;
+		if (match.length == 0 || match.length > Dictionary::kMaxWordLength) return false;
+		if (match.path >> (3 * (match.length - 1)) != 0) return false;
+		int row = match.row;
+		int col = match.col;
+		if (row >= rows || col >= cols) return false;
+		for (int i = 0; i < match.length - 1; ++i) {
+			const Direction& d = kDirections[match.path >> (3 * (match.length - 2 - i)) & 7];
+			row += d.row;
+			col += d.col;
+			if (row < 0 || row >= rows || col < 0 || col >= cols) return false;
+		}
+		return true;
+	}
+
+	// EFFECTS: Writes header and every board in the cache (least recently
+	// used first) to the file
+	// NOTES: Writes a temporary file next to it and renames that over the
+	// file, so a crash never leaves it half written. Callers hold the
+	// exclusive file lock (see load_file and compact_file)
+	void rewrite_file(void) {
+#if defined(_WIN32)
+		std::string temporary = filename + ".tmp";
+#else
+		std::string temporary = filename + ".tmp" + std::to_string(getpid());
+#endif
+		File_Not_Open error;
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			if (file.is_open() == false) throw error;
+			file << file_header();
+			for (auto it = entries.rbegin(); it != entries.rend(); ++it) file << record(it->key, it->matches);
+			file.close();
+			if (file.fail()) {
+				std::remove(temporary.c_str());
+				throw error;
+			}
+		}
+#if defined(_WIN32)
+		// Windows does not rename over a file that exists
+		std::remove(filename.c_str());
+#endif
+		if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+			std::remove(temporary.c_str());
+			throw error;
+		}
+	}
+
+	// EFFECTS: Appends bytes, a record (see record), to the file
+	// NOTES: The record is one write(2) on an O_APPEND file, so solvers in
+	// other threads or processes appending to the same file do not mix
+	// their records
+	void append_file(const std::string& bytes) {
+		File_Lock file_lock(filename, false);
+#if defined(_WIN32)
+		std::ofstream file(filename, std::ios::binary | std::ios::app);
+		File_Not_Open error;
+		if (file.is_open() == false) throw error;
+		file.write(bytes.data(), (std::streamsize)bytes.size());
+#else
+		int fd = open(filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+		File_Not_Open error;
+		if (fd < 0) throw error;
+		ssize_t written = write(fd, bytes.data(), bytes.size());
+		close(fd);
+		if (written != (ssize_t)bytes.size()) throw error;
+#endif
+	}
+
+	static void put_u16(std::string& bytes, uint16_t value) {
+		bytes += (char)(value & 0xFF);
+		bytes += (char)(value >> 8);
+	}
+	static void put_u32(std::string& bytes, uint32_t value) {
+		for (int i = 0; i < 4; ++i) bytes += (char)(value >> (8 * i) & 0xFF);
+	}
+	static uint16_t get_u16(const std::string& bytes, size_t at) {
+		return (uint16_t)((uint8_t)bytes[at] | (uint8_t)bytes[at + 1] << 8);
+	}
+	static uint32_t get_u32(const std::string& bytes, size_t at) {
+		uint32_t value = 0;
+		for (int i = 0; i < 4; ++i) value |= (uint32_t)(uint8_t)bytes[at + i] << (8 * i);
+		return value;
+	}
+};
+
+
+// Board to solve in process (see Solve_Context)
+struct Board {
+	int width = 0;
+	int height = 0;
+	std::string letters;			// width * height letters, row major
+};
+
+
+// Results of one solve (see Solve_Context). Every result's cells are
+// cells[first_cell] to cells[first_cell + length - 1], one per letter as
+// row * width + col
+struct Solve_Result {
+	uint32_t word_id = 0;	// Index of word in dictionary
+	std::string_view word;		// Points into the Dictionary
+	uint32_t points = 0;	// See Score_Table
+	uint32_t first_cell = 0;
+	uint32_t length = 0;
+};
+
+struct Solve_Results {
+	int width = 0;
+	int height = 0;
+	std::vector<Solve_Result> words;
+	std::vector<uint32_t> cells;
+};
+
+
+// Word Hunt Core
+// The board, the search engines and the results of the last board, without
+// any output. Solve_Context solves with it, and the command line program
+// (Word_Hunt_Solver in Word_Hunt_Solver.cpp) prints on top of it
+class Word_Hunt_Core {
+protected:
+	// Board letters, row major in one buffer with a one cell border of
+	// Dictionary::kNoLetter all the way around. Stepping off the board lands
+	// on the border, which fails the letter test like any other mismatch
+	std::vector<char> board;
+	int stride = 0;							// width + 2
+	std::array<int, 8> neighbor_offsets = {};	// kDirections[i] as an offset into board
+	std::shared_ptr<const Dictionary> dictionary;
+	int width = 0;
+	int height = 0;
+	bool point_on = false;
+	bool alpha_on = false;
+	bool linear_on = false;
+	int search_depth = 6;				// Default Search Depth value is 6
+	// File can be found here: https://drive.google.com/file/d/1oGDf1wjWp5RF_X9C7HoedhIWMh5uJs8s/view
+	std::string dictionary_filename = "Collins_Scrabble_Words_(2019).txt";
+	bool specifed_length_on = false;
+	bool specifed_first_letter_on = false;
+	int specified_length = 0;
+	std::vector<char> specified_first_letters;
+	uint32_t first_letter_mask = 0;		// Bit i set if -y has letter 'A' + i
+	bool word_hunt_mode_on = false;
+	Engine_Mode engine_mode = Engine_Mode::k_Trie_Engine;
+	bool scan_engine_on = false;
+	bool iterative_engine_on = false;
+	bool linear_engine_on = false;
+	bool unique_on = false;
+	bool stats_on = false;
+	bool word_hunt_scoring_on = false;
+	Score_Table score_table = Score_Table::by_length();
+	size_t top_count = 0;				// 0 = keep every result
+	bool edit_mode_on = false;			// Keep edit_cache for apply_edits
+	int thread_count = 1;
+
+	// Found Word struct
+	// A found word is a dictionary id, its first cell and the direction taken
+	// into every following letter, packed 3 bits (index into kDirections) per
+	// step with the first step in the highest bits. Everything printed about
+	// it is decoded from the path when it is printed (see path_step)
+	struct Found_Word {
+		uint32_t word_id = 0;				// Index of word in dictionary
+		uint16_t row = 0;					// First letter
+		uint16_t col = 0;
+		uint8_t length = 0;
+		bool word_hunt_valid = false;
+		uint32_t points = 0;				// See Score_Table
+		uint64_t path = 0;
+	};
+
+	// Results of the current board (reset between boards)
+	Arena<Found_Word> found_words;
+	// Unique mode: word_seen[id] == seen_generation if word id is already in
+	// found_words. Bumping seen_generation forgets every word in O(1)
+	std::vector<uint32_t> word_seen;
+	uint32_t seen_generation = 0;
+	// Top mode: best top_count results so far, kept as a heap with the worst
+	// one on top (see better_result), so memory stays O(top_count)
+	struct Top_Entry {
+		Found_Word found_word;
+		uint64_t sequence;					// Order found in, breaks ties
+	};
+	std::vector<Top_Entry> top_heap;
+	uint64_t top_sequence = 0;
+
+	// Scratch buffers of trie_solver, kept between boards. With more than
+	// one thread, start_cell_matches[i] collects matches of start_cells[i]
+	std::vector<std::pair<int, int>> start_cells;
+	std::vector<Found_Word> matches;
+	std::vector<std::vector<Found_Word>> start_cell_matches;
+	// Workers of multithreaded searches, nullptr with one thread. Kept
+	// between boards and only restarted when the thread count changes
+	std::unique_ptr<Work_Stealing_Pool> pool;
+	// Scratch buffer of scan_solver (word ids to scan with -x/-y)
+	std::vector<uint32_t> scan_ids;
+
+	// Bitboard tables for Word Hunt boards of up to 64 cells (see
+	// bitboard_recursive). Cells are numbered row major
+	static constexpr int kMaxBitboardCells = 64;
+	bool bitboard_on = false;
+	std::vector<char> cell_letters;					// Letter of each cell
+	std::vector<std::array<int8_t, 8>> neighbor_cells;	// Neighbor per direction, -1 if off board
+	std::vector<uint64_t> neighbor_masks;			// Bit n set if cell n is a neighbor
+
+	// Linear engine automaton, made the first time linear_solver runs
+	std::unique_ptr<Line_Automaton> line_automaton;
+
+	// Scan engine letter bitmaps: bit n % 64 of
+	// letter_cells[letter * cell_words + n / 64] is set if cell n (row major)
+	// holds 'A' + letter. One spare word per letter past the last cell
+	int cell_words = 0;
+	std::vector<uint64_t> letter_cells;
+
+	// Incremental solves (see apply_edits). edit_cache has every match of
+	// the board before -u and --top, sorted by found_word_less. With
+	// edit_mode_on run_solver fills it from captured.
+	// edit_distance[cell] (index into board) is the distance to the closest
+	// edited cell, kFarFromEdits at most
+	static constexpr int kFarFromEdits = 255;
+	bool edit_cache_valid = false;
+	std::vector<Found_Word> edit_cache;
+	std::vector<uint8_t> edit_distance;
+	int edit_max_length = 0;
+
+	// Board cache (see Board_Cache), nullptr unless --cache. While capture_on,
+	// store_found_word also adds every match to captured (before -u and
+	// --top), which is what the cache and edit_cache keep. cache_key and
+	// cache_symmetry belong to the board being solved. Solvers with the same
+	// --cache-file share board_cache (see Board_Cache::shared)
+	std::shared_ptr<Board_Cache> board_cache;
+	std::string cache_settings;					// What board_cache was made with (see configure)
+	uint64_t dictionary_hash = 0;				// Dictionary::content_hash, set by configure
+	bool dictionary_hash_valid = false;
+	bool capture_on = false;
+	std::vector<Found_Word> captured;
+	std::string cache_letters;
+	std::string cache_key;
+	std::string cache_scratch;
+	int cache_symmetry = 0;
+	std::vector<Board_Cache::Match> cache_matches;
+
+	// Word Hunt mode of the iterative engine: iterative_on_path[worker][cell]
+	// is 1 while cell (index into board) is on the path worker is searching
+	std::vector<std::vector<uint8_t>> iterative_on_path;
+
+	// Flat copy of 4x4 and 5x5 boards for fixed_recursive. fixed_search is
+	// chosen by select_fixed_search, nullptr for every other size
+	std::array<char, 25> fixed_letters = {};
+	void (Word_Hunt_Core::*fixed_search)(const std::pair<int, int>&, std::vector<Found_Word>&, Search_Stats&) = nullptr;
+
+	// --stats: counters of every worker thread (one for single threaded
+	// searches), summed over every board
+	std::vector<Search_Stats> thread_stats;
+	double create_list_seconds = 0;
+
+	// Sorted views of found_words (indexes into it), filled by sort_results
+	// for -p and -a. Matches of the same word keep the order they were found in
+	std::vector<uint32_t> point_order;
+	std::vector<uint32_t> alpha_order;
+	// Scratch of sort_results: alphabetical rank of every found word id
+	// (indexed by word id, sized to the dictionary once)
+	std::vector<uint32_t> word_rank;
+	std::vector<uint32_t> ranked_ids;
+	std::vector<uint32_t> sort_scratch;
+	
+	// EFFECTS: Creates list of valid words (either parses the text word list
+	// or maps a dictionary compiled with --compile-dictionary)
+	void create_list(void) {
+		auto loaded = std::make_shared<Dictionary>();
+		loaded->load(dictionary_filename);
+		dictionary = loaded;
+	}
+
+	// EFFECTS: Returns true if a comes before b in the order every engine
+	// stores matches in: word id, start cell (row major), then path. Paths of
+	// one word have the same length, so comparing packed paths compares them
+	// direction by direction
+	static bool found_word_less(const Found_Word& a, const Found_Word& b) {
+		if (a.word_id != b.word_id) return a.word_id < b.word_id;
+		if (a.row != b.row) return a.row < b.row;
+		if (a.col != b.col) return a.col < b.col;
+		return a.path < b.path;
+	}
+
+	// EFFECTS: Returns kDirections index of step i of found_word's path
+	// (step 0 goes from the first letter to the second)
+	static int path_step(const Found_Word& found_word, int i) {
+		return (int)(found_word.path >> (3 * (found_word.length - 2 - i)) & 7);
+	}
+
+	// EFFECTS: Calls visit(row, col) for every letter of found_word's path,
+	// first letter first
+	template <class Visit>
+	static void for_each_path_cell(const Found_Word& found_word, Visit visit) {
+		int row = found_word.row;
+		int col = found_word.col;
+		visit(row, col);
+		for (int i = 0; i < found_word.length - 1; ++i) {
+			const Direction& d = kDirections[path_step(found_word, i)];
+			row += d.row;
+			col += d.col;
+			visit(row, col);
+		}
+	}
+
+	// EFFECTS: Returns true if every step of found_word's path goes the same
+	// direction
+	static bool path_is_linear(const Found_Word& found_word) {
+		for (int i = 1; i < found_word.length - 1; ++i) {
+			if (path_step(found_word, i) != path_step(found_word, 0)) return false;
+		}
+		return true;
+	}
+
+	// EFFECTS: Returns true if found_word's path never visits a cell twice
+	// ("Word Hunt Valid")
+	static bool path_is_word_hunt_valid(const Found_Word& found_word) {
+		int rows[Dictionary::kMaxWordLength];
+		int cols[Dictionary::kMaxWordLength];
+		rows[0] = found_word.row;
+		cols[0] = found_word.col;
+		for (int i = 1; i < found_word.length; ++i) {
+			const Direction& d = kDirections[path_step(found_word, i - 1)];
+			rows[i] = rows[i - 1] + d.row;
+			cols[i] = cols[i - 1] + d.col;
+			for (int j = 0; j < i; ++j) {
+				if (rows[i] == rows[j] && cols[i] == cols[j]) return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	// Defualt Constructor
+	// Note: Loads the dictionary unless shared_dictionary is given (lets
+	// several solvers share one Dictionary, see Solver_Server)
+	Word_Hunt_Core(const Core_Options& options, std::shared_ptr<const Dictionary> shared_dictionary = nullptr)
+		: dictionary(shared_dictionary) {
+		if (options.dictionary_mode == Dictionary_Mode::k_Dictionary_Mode_On) dictionary_filename = options.dictionary_filename;
+		if (dictionary == nullptr) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			create_list();
+			create_list_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+		configure(options);
+	}
+
+	// EFFECTS: Switches to the search options of options. The dictionary
+	// and every scratch buffer are kept, and so is the board cache unless
+	// its options changed. The results of the last board are dropped
+	void configure(const Core_Options& options) {
+		point_on = options.point_output_mode == Point_Output_Mode::k_Point_Mode_On;
+		alpha_on = options.alpha_output_mode == Alpha_Output_Mode::k_Alpha_Mode_On;
+		linear_on = options.linear_mode == Linear_Search_Only_Mode::k_Linear_Search_Mode_On;
+		// Change search_depth value if specified
+		search_depth = 6;
+		if (options.search_depth_output_mode == Search_Depth_Output_Mode::k_Search_Depth_Mode_On) search_depth = options.search_depth;
+
+		// Word Hunt Mode
+		word_hunt_mode_on = options.word_hunt_mode == Word_Hunt_Mode::k_Word_Hunt_Mode_On;
+
+		// Specified length/first letter
+		specifed_length_on = options.specify_length_mode == Specify_Length_Mode::k_Specify_Length_Mode_on;
+		specifed_first_letter_on = options.specify_first_letter_mode == Specify_First_Letter_Mode::k_Specify_First_Letter_Mode_On;
+		specified_length = specifed_length_on ? options.specified_length : 0;
+		specified_first_letters.clear();
+		if (specifed_first_letter_on == true) {
+			// Anything but A-Z can not start a word (and would shift
+			// first_letter_mask out of range), so it is left out
+			for (char letter : options.specified_first_letters) {
+				if (letter >= 'A' && letter <= 'Z') specified_first_letters.push_back(letter);
+			}
+		}
+		first_letter_mask = 0;
+		for (char letter : specified_first_letters) first_letter_mask |= 1u << (letter - 'A');
+
+		// Search engine
+		engine_mode = options.engine_mode;
+		scan_engine_on = options.engine_mode == Engine_Mode::k_Scan_Engine;
+		iterative_engine_on = options.engine_mode == Engine_Mode::k_Iterative_Engine;
+		// The linear engine only finds straight lines, so it implies -l
+		linear_engine_on = options.engine_mode == Engine_Mode::k_Linear_Engine;
+		if (linear_engine_on) linear_on = true;
+		unique_on = options.unique_mode == Unique_Mode::k_Unique_Mode_On;
+		stats_on = options.stats_mode == Stats_Mode::k_Stats_Mode_On;
+		word_hunt_scoring_on = options.scoring_mode == Scoring_Mode::k_Word_Hunt_Scoring;
+		score_table = word_hunt_scoring_on ? Score_Table::word_hunt() : Score_Table::by_length();
+		top_count = 0;
+		if (options.top_mode == Top_Mode::k_Top_Mode_On) top_count = (size_t)options.top_count;
+		edit_mode_on = options.edit_mode == Edit_Mode::k_Edit_Mode_On;
+		thread_count = 1;
+		if (options.threads_mode == Threads_Mode::k_Threads_Mode_On) {
+			thread_count = options.thread_count;
+			if (thread_count <= 0) thread_count = std::max(1, (int)std::thread::hardware_concurrency());
+		}
+		thread_stats.resize(std::max(1, thread_count));
+		if (thread_count <= 1) pool.reset();
+		else if (pool == nullptr || pool->size() != thread_count) pool.reset(new Work_Stealing_Pool(thread_count));
+
+		if (options.cache_mode == Cache_Mode::k_Cache_Mode_On) {
+			// The dictionary never changes, so it is only hashed once
+			if (dictionary_hash_valid == false) {
+				dictionary_hash = dictionary->content_hash();
+				dictionary_hash_valid = true;
+			}
+			std::string signature = cache_signature();
+			std::string settings = std::to_string(options.cache_entries) + " " + options.cache_filename + " " + signature;
+			if (board_cache == nullptr || settings != cache_settings) {
+				board_cache = Board_Cache::shared((size_t)options.cache_entries, options.cache_filename, signature, (uint32_t)dictionary->size());
+				cache_settings = settings;
+			}
+		}
+		else board_cache.reset();
+
+		// The search and the kept matches depend on the options
+		select_fixed_search();
+		edit_cache_valid = false;
+		clear_results();
+	}
+
+	// EFFECTS: Writes edits to the board and brings the results up to date,
+	// as if the edited board had been solved. Returns the words that can be
+	// found now but not before (added) and the other way around (removed)
+	// NOTES: Only paths that go through an edited cell can change. Those are
+	// dropped from the cached matches (see edit_cache) and searched again,
+	// starting only from cells close enough to an edited cell to reach it
+	// within the search depth, and dropping paths that wander too far from
+	// every edited cell to still reach one. With edit_mode_on the solve
+	// already filled the cache (see run_solver), otherwise the first call
+	// after a solve searches the whole board once to fill it
+	// Throws Invalid_Edit if an edit is off the board
+	Board_Diff apply_edits(const std::vector<Cell_Edit>& cell_edits) {
+		for (const auto& edit : cell_edits) {
+			Invalid_Edit error;
+			if (dimensions_valid(edit.row, edit.col) == false) throw error;
+		}
+		edit_max_length = std::min(search_depth, Dictionary::kMaxWordLength);
+		if (specifed_length_on == true) edit_max_length = std::min(edit_max_length, specified_length);
+		if (edit_cache_valid == false) {
+			// Every cell counts as edited, so every path is searched
+			edit_distance.assign(board.size(), 0);
+			edit_cache.clear();
+			search_edited(edit_cache);
+			std::sort(edit_cache.begin(), edit_cache.end(), found_word_less);
+			edit_cache_valid = true;
+		}
+		std::vector<uint32_t> before = shown_word_ids();
+
+		// Chebyshev distance of every cell to the closest edited cell
+		edit_distance.assign(board.size(), kFarFromEdits);
+		for (const auto& edit : cell_edits) board[cell_index(edit.row, edit.col)] = edit.letter;
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) {
+				int distance = kFarFromEdits;
+				for (const auto& edit : cell_edits) {
+					distance = std::min(distance, std::max(std::abs(row - edit.row), std::abs(col - edit.col)));
+				}
+				edit_distance[cell_index(row, col)] = (uint8_t)distance;
+			}
+		}
+		select_fixed_search();
+
+		edit_cache.erase(std::remove_if(edit_cache.begin(), edit_cache.end(), [&](const Found_Word& found_word) {
+			return path_touches_edit(found_word);
+		}), edit_cache.end());
+		size_t kept = edit_cache.size();
+		search_edited(edit_cache);
+		std::sort(edit_cache.begin() + kept, edit_cache.end(), found_word_less);
+		std::inplace_merge(edit_cache.begin(), edit_cache.begin() + kept, edit_cache.end(), found_word_less);
+
+		clear_results();
+		for (const auto& found_word : edit_cache) store_found_word(found_word);
+		if (top_count > 0) finish_top_results();
+
+		Board_Diff diff;
+		std::vector<uint32_t> after = shown_word_ids();
+		std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(diff.added));
+		std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(diff.removed));
+		return diff;
+	}
+
+	// EFFECTS: Solves new_board and replaces results with its results, in
+	// the same order and with the same filters as the output. Nothing is
+	// printed
+	// Throws Invalid_Board if new_board is not a valid board (see set_board)
+	void solve(const Board& new_board, Solve_Results& results) {
+		Invalid_Board error;
+		if (set_board(new_board) == false) throw error;
+		clear_results();
+		run_solver();
+		export_results(results);
+	}
+
+	// EFFECTS: Writes cell_edits to the board solved last and replaces
+	// results with the results of the edited board (see apply_edits).
+	// Returns the words that were added and removed
+	// Throws Invalid_Edit if an edit is off the board
+	Board_Diff solve_edits(const std::vector<Cell_Edit>& cell_edits, Solve_Results& results) {
+		Board_Diff diff = apply_edits(cell_edits);
+		export_results(results);
+		return diff;
+	}
+
+	// EFFECTS: Replaces results with the stored results, in the same order
+	// and with the same filters as the output
+	void export_results(Solve_Results& results) {
+		results.width = width;
+		results.height = height;
+		results.words.clear();
+		results.cells.clear();
+		for_each_result([&](const Found_Word& found_word) {
+			Solve_Result result;
+			result.word_id = found_word.word_id;
+			result.word = dictionary->word(found_word.word_id);
+			result.points = found_word.points;
+			result.first_cell = (uint32_t)results.cells.size();
+			result.length = found_word.length;
+			for_each_path_cell(found_word, [&](int row, int col) { results.cells.push_back((uint32_t)(row * width + col)); });
+			results.words.push_back(result);
+		});
+	}
+
+	// EFFECTS: Returns number of results of last board that pass -w and -l
+	size_t result_count(void) const {
+		size_t count = 0;
+		for (size_t i = 0; i < found_words.size(); ++i) {
+			if (shown(found_words[i])) ++count;
+		}
+		return count;
+	}
+
+protected:
+	// EFFECTS: Calls visit on every result that passes -w and -l, in -p
+	// order, else -a order, else the order they were found in
+	template <class Visit>
+	void for_each_result(Visit visit) {
+		sort_results();
+		if (point_on) {
+			for (uint32_t i : point_order) {
+				if (shown(found_words[i])) visit(found_words[i]);
+			}
+		}
+		else if (alpha_on) {
+			for (uint32_t i : alpha_order) {
+				if (shown(found_words[i])) visit(found_words[i]);
+			}
+		}
+		else {
+			for (size_t i = 0; i < found_words.size(); ++i) {
+				if (shown(found_words[i])) visit(found_words[i]);
+			}
+		}
+	}
+
+	// EFFECTS: Returns true if found_word passes -w and -l
+	bool shown(const Found_Word& found_word) const {
+		if (word_hunt_mode_on == true && found_word.word_hunt_valid == false) return false;
+		if (linear_on == true && path_is_linear(found_word) == false) return false;
+		return true;
+	}
+
+	// EFFECTS: Forgets results of previous board, keeping allocated memory
+	void clear_results(void) {
+		found_words.reset();
+		point_order.clear();
+		alpha_order.clear();
+		top_heap.clear();
+		top_sequence = 0;
+		if (unique_on) {
+			if (word_seen.size() != dictionary->size() || ++seen_generation == 0) {
+				word_seen.assign(dictionary->size(), 0);
+				seen_generation = 1;
+			}
+		}
+	}
+
+	// EFFECTS: Fills alpha_order (-a) and point_order (-p) with found_words
+	// sorted alphabetically, and by points (most first) then alphabetically
+	// NOTES: Distinct found words are ranked alphabetically first, which only
+	// compares strings once per distinct word. The matches are then radix
+	// sorted by rank, and stably by points for point_order
+	// Time Complexity: O(n + k log k), k = distinct words found
+	void sort_results(void) {
+		if (point_on == false && alpha_on == false) return;
+		alpha_order.resize(found_words.size());
+		for (size_t i = 0; i < found_words.size(); ++i) alpha_order[i] = (uint32_t)i;
+
+		word_rank.resize(dictionary->size());
+		ranked_ids.clear();
+		for (size_t i = 0; i < found_words.size(); ++i) ranked_ids.push_back(found_words[i].word_id);
+		std::sort(ranked_ids.begin(), ranked_ids.end());
+		ranked_ids.erase(std::unique(ranked_ids.begin(), ranked_ids.end()), ranked_ids.end());
+		std::sort(ranked_ids.begin(), ranked_ids.end(), [this](uint32_t a, uint32_t b) {
+			return dictionary->word(a) < dictionary->word(b);
+		});
+		// Equal words (duplicates in the word list) share a rank
+		uint32_t rank = 0;
+		for (size_t i = 0; i < ranked_ids.size(); ++i) {
+			if (i > 0 && dictionary->word(ranked_ids[i]) != dictionary->word(ranked_ids[i - 1])) ++rank;
+			word_rank[ranked_ids[i]] = rank;
+		}
+		radix_sort(alpha_order, rank + 1, [this](uint32_t i) { return word_rank[found_words[i].word_id]; });
+
+		if (point_on) {
+			point_order = alpha_order;
+			uint32_t max_points = score_table.max_points();
+			radix_sort(point_order, max_points + 1,
+				[this, max_points](uint32_t i) { return max_points - found_words[i].points; });
+		}
+	}
+
+	// EFFECTS: Stably sorts order by key(order[i]), which is less than limit
+	// (least significant byte first, one counting pass per byte of limit)
+	template <class Key>
+	void radix_sort(std::vector<uint32_t>& order, uint32_t limit, Key key) {
+		sort_scratch.resize(order.size());
+		for (int shift = 0; shift < 32 && (limit - 1) >> shift != 0; shift += 8) {
+			size_t counts[257] = {};
+			for (uint32_t i : order) ++counts[((key(i) >> shift) & 0xFF) + 1];
+			for (int b = 0; b < 256; ++b) counts[b + 1] += counts[b];
+			for (uint32_t i : order) sort_scratch[counts[(key(i) >> shift) & 0xFF]++] = i;
+			order.swap(sort_scratch);
+		}
+	}
+
+
+	// EFFECTS: Runs selected search engine
+	// NOTES: With --cache the board is looked up first, and a board that
+	// is not cached yet is stored once it is searched. With edit_mode_on
+	// the matches are kept in edit_cache, so apply_edits does not have to
+	// search the whole board again
+	void run_solver(void) {
+		capture_on = board_cache != nullptr || edit_mode_on;
+		captured.clear();
+		if (board_cache == nullptr || cached_solve() == false) {
+			if (scan_engine_on) scan_solver();
+			else if (linear_engine_on) {
+				if (stats_on) linear_solver<true>();
+				else linear_solver<false>();
+			}
+			else trie_solver();
+			if (board_cache != nullptr) cache_results();
+		}
+		capture_on = false;
+		if (edit_mode_on) {
+			// Copied rather than swapped, so both keep their memory
+			edit_cache.assign(captured.begin(), captured.end());
+			if (std::is_sorted(edit_cache.begin(), edit_cache.end(), found_word_less) == false) {
+				std::sort(edit_cache.begin(), edit_cache.end(), found_word_less);
+			}
+			edit_cache_valid = true;
+		}
+		if (top_count > 0) finish_top_results();
+	}
+
+	// EFFECTS: Stores the matches board_cache has for the board (or a turn or
+	// flip of it), moved onto the board. Returns false if it has none
+	// NOTES: Sets cache_key and cache_symmetry for cache_results
+	bool cached_solve(void) {
+		cache_letters.clear();
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) cache_letters += at(row, col);
+		}
+		cache_symmetry = Board_Cache::canonical(cache_letters, height, width, cache_key, cache_scratch);
+		if (board_cache->find(cache_key, cache_matches) == false) return false;
+		int back = Board_Cache::inverse(cache_symmetry);
+		int rows = Board_Cache::transposes(cache_symmetry) ? width : height;
+		int cols = Board_Cache::transposes(cache_symmetry) ? height : width;
+		matches.clear();
+		for (const auto& match : cache_matches) {
+			Board_Cache::Match moved = Board_Cache::transform(match, back, rows, cols);
+			Found_Word found_word;
+			found_word.word_id = moved.word_id;
+			found_word.row = moved.row;
+			found_word.col = moved.col;
+			found_word.length = moved.length;
+			found_word.word_hunt_valid = moved.word_hunt_valid;
+			found_word.points = score_table(moved.length);
+			found_word.path = moved.path;
+			matches.push_back(found_word);
+		}
+		// Turning the board changes which start cell and path of a word come
+		// first. Matches stay grouped by word, so only each word is sorted
+		if (back != 0) {
+			auto first = matches.begin();
+			while (first != matches.end()) {
+				auto last = first + 1;
+				while (last != matches.end() && last->word_id == first->word_id) ++last;
+				if (last - first > 1) std::sort(first, last, found_word_less);
+				first = last;
+			}
+		}
+		for (const auto& found_word : matches) store_found_word(found_word);
+		return true;
+	}
+
+	// EFFECTS: Stores the matches of the last search (captured) in
+	// board_cache, turned like cache_key and in the order engines store
+	// matches in
+	void cache_results(void) {
+		std::vector<Board_Cache::Match> stored;
+		stored.reserve(captured.size());
+		for (const auto& found_word : captured) {
+			Board_Cache::Match match;
+			match.word_id = found_word.word_id;
+			match.row = found_word.row;
+			match.col = found_word.col;
+			match.length = found_word.length;
+			match.word_hunt_valid = found_word.word_hunt_valid;
+			match.path = found_word.path;
+			stored.push_back(Board_Cache::transform(match, cache_symmetry, height, width));
+		}
+		std::sort(stored.begin(), stored.end(), [](const Board_Cache::Match& a, const Board_Cache::Match& b) {
+			if (a.word_id != b.word_id) return a.word_id < b.word_id;
+			if (a.row != b.row) return a.row < b.row;
+			if (a.col != b.col) return a.col < b.col;
+			return a.path < b.path;
+		});
+		board_cache->insert(cache_key, std::move(stored));
+	}
+
+	// EFFECTS: Returns what the board cache file must have been written with
+	// for its matches to be the ones this solver would find
+	std::string cache_signature(void) const {
+		return "dictionary " + std::to_string(dictionary_hash)
+			+ " depth " + std::to_string(search_depth) + " length " + std::to_string(specifed_length_on ? specified_length : 0)
+			+ " first " + std::to_string(first_letter_mask) + " word-hunt " + std::to_string(word_hunt_mode_on)
+			+ " linear " + std::to_string(linear_on) + " engine " + std::to_string((int)engine_mode);
+	}
+
+	// EFFECTS: Runs solver for each potential word in word list
+	// NOTES: Words with a letter the board does not have are skipped without
+	// searching. In Word Hunt mode a path never uses a cell twice, so words
+	// that need some letter more often than the board has it are skipped too
+	// (see Dictionary::Letter_Histogram). Their only paths would be ones -w
+	// drops anyway
+	void scan_solver(void) {
+		Search_Stats& stats = thread_stats[0];
+		Dictionary::Letter_Histogram board_histogram;
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) board_histogram.add(at(row, col));
+		}
+		create_letter_bitmaps();
+		auto scan = [&](uint32_t id) {
+			if (word_hunt_mode_on == true && dictionary->histogram(id).fits_in(board_histogram) == false) return;
+			if (dictionary->histogram(id).letters_in(board_histogram) == false) return;
+			std::string_view word = dictionary->word(id);
+			if (stats_on) find_word<true>(word, id, stats);
+			else find_word<false>(word, id, stats);
+		};
+		if (specifed_length_on == false && specifed_first_letter_on == false) {
+			for (uint32_t id = 0; id < dictionary->size(); ++id) scan(id);
+			return;
+		}
+		// -x/-y: only the matching (first letter, length) buckets. Words are
+		// still scanned in id order, so the results come out the same
+		scan_ids.clear();
+		int buckets = 0;
+		for (int letter = 0; letter < Dictionary::kLetterBuckets; ++letter) {
+			if (specifed_first_letter_on == true && (letter >= 26 || (first_letter_mask >> letter & 1) == 0)) continue;
+			for (int length = 1; length < Dictionary::kLengthBuckets; ++length) {
+				if (specifed_length_on == true && length != specified_length) continue;
+				auto range = dictionary->bucket(letter, length);
+				scan_ids.insert(scan_ids.end(), range.first, range.second);
+				++buckets;
+			}
+		}
+		if (buckets > 1) std::sort(scan_ids.begin(), scan_ids.end());
+		for (uint32_t id : scan_ids) scan(id);
+	}
+
+	// EFFECTS: Runs one search per board cell, walking the trie alongside
+	// the board so that a path is dropped as soon as it is no longer a
+	// prefix of any word
+	// NOTES: Matches come out grouped by start cell, so they are sorted by
+	// word id, start cell and path afterwards. Paths of one word have the same
+	// length, so comparing packed paths compares them direction by direction,
+	// which gives the exact order scan_solver produces
+	// With more than one thread every start cell is a task of a
+	// Work_Stealing_Pool. Each cell collects its matches in its own vector, and
+	// those are joined in cell order, so the result is the same as one thread
+	void trie_solver(void) {
+		start_cells.clear();
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) {
+				if (specifed_first_letter_on == true) {
+					if ((first_letter_mask >> (at(row, col) - 'A') & 1) == 0) continue;
+				}
+				start_cells.emplace_back(row, col);
+			}
+		}
+
+		// Word Hunt paths may not revisit a cell, which small boards can
+		// check with a 64 bit mask while searching
+		bitboard_on = word_hunt_mode_on == true && width * height <= kMaxBitboardCells && !iterative_engine_on;
+		if (bitboard_on) create_bitboard_tables();
+		if (iterative_engine_on) {
+			iterative_on_path.resize(thread_stats.size());
+			for (auto& on_path : iterative_on_path) on_path.assign(board.size(), 0);
+		}
+
+		// Top mode: matches of one word come out in the same relative order
+		// either way, which is all store_found_word needs to pick the best
+		// top_count, so each cell is stored as soon as it is searched
+		matches.clear();
+		if (thread_count <= 1 && top_count > 0) {
+			for (const auto& original : start_cells) {
+				matches.clear();
+				search_from(original, matches, 0);
+				for (const auto& found_word : matches) store_found_word(found_word);
+			}
+			return;
+		}
+		if (thread_count <= 1) {
+			for (const auto& original : start_cells) search_from(original, matches, 0);
+		}
+		else {
+			if (start_cell_matches.size() < start_cells.size()) start_cell_matches.resize(start_cells.size());
+			for (size_t i = 0; i < start_cells.size(); ++i) start_cell_matches[i].clear();
+			pool->run(start_cells.size(), [&](size_t i, int worker) {
+				search_from(start_cells[i], start_cell_matches[i], worker);
+			});
+			if (top_count > 0) {
+				for (size_t i = 0; i < start_cells.size(); ++i) {
+					for (const auto& found_word : start_cell_matches[i]) store_found_word(found_word);
+				}
+				return;
+			}
+			for (size_t i = 0; i < start_cells.size(); ++i) {
+				matches.insert(matches.end(), start_cell_matches[i].begin(), start_cell_matches[i].end());
+			}
+		}
+		std::sort(matches.begin(), matches.end(), found_word_less);
+		for (const auto& found_word : matches) store_found_word(found_word);
+	}
+
+	// EFFECTS: Runs trie search starting at original on worker (0 with one
+	// thread)
+	void search_from(const std::pair<int, int>& original, std::vector<Found_Word>& cell_matches, int worker) {
+		Search_Stats& stats = thread_stats[worker];
+		if (iterative_engine_on) {
+			if (stats_on) iterative_search<true>(original, cell_matches, worker);
+			else iterative_search<false>(original, cell_matches, worker);
+		}
+		else if (fixed_search != nullptr) {
+			(this->*fixed_search)(original, cell_matches, stats);
+		}
+		else if (bitboard_on) {
+			int cell = original.first * width + original.second;
+			if (stats_on) bitboard_recursive<true>(dictionary->root(), cell, 0, 0, 0, original, cell_matches, stats);
+			else bitboard_recursive<false>(dictionary->root(), cell, 0, 0, 0, original, cell_matches, stats);
+		}
+		else {
+			int cell = cell_index(original.first, original.second);
+			if (stats_on) trie_recursive<true>(dictionary->root(), cell, 0, -1, 0, original, cell_matches, stats);
+			else trie_recursive<false>(dictionary->root(), cell, 0, -1, 0, original, cell_matches, stats);
+		}
+	}
+
+	// EFFECTS: Picks fixed size search for the current board, if there is one
+	void select_fixed_search(void) {
+		fixed_search = nullptr;
+		if (width == 4 && height == 4) fixed_search = fixed_search_for<4, 4>();
+		else if (width == 5 && height == 5) fixed_search = fixed_search_for<5, 5>();
+		if (fixed_search == nullptr) return;
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) fixed_letters[row * width + col] = at(row, col);
+		}
+	}
+
+	// EFFECTS: Returns fixed size search for W x H boards matching -w and
+	// --stats
+	template <int W, int H>
+	decltype(fixed_search) fixed_search_for(void) {
+		if (word_hunt_mode_on) {
+			if (stats_on) return &Word_Hunt_Core::fixed_search_from<W, H, true, true>;
+			return &Word_Hunt_Core::fixed_search_from<W, H, true, false>;
+		}
+		if (stats_on) return &Word_Hunt_Core::fixed_search_from<W, H, false, true>;
+		return &Word_Hunt_Core::fixed_search_from<W, H, false, false>;
+	}
+
+	// EFFECTS: Runs fixed size search starting at original
+	template <int W, int H, bool kWordHunt, bool kStats>
+	void fixed_search_from(const std::pair<int, int>& original, std::vector<Found_Word>& cell_matches, Search_Stats& stats) {
+		fixed_recursive<W, H, kWordHunt, kStats>(dictionary->root(), original.first * W + original.second, 0, 0, -1, 0,
+			original, cell_matches, stats);
+	}
+
+	// EFFECTS: Same search as bitboard_recursive (kWordHunt) or trie_recursive
+	// (!kWordHunt), but the board size is known at compile time, so the
+	// neighbor table is a constant and the direction loop can be unrolled
+	template <int W, int H, bool kWordHunt, bool kStats>
+	void fixed_recursive(uint32_t node, int cell, int depth, uint64_t visited, int prev_index,
+		uint64_t path, const std::pair<int, int>& original, std::vector<Found_Word>& cell_matches, Search_Stats& stats) {
+		constexpr const Fixed_Board_Geometry<W, H>& geometry = kFixedGeometry<W, H>;
+		if (kStats) ++stats.nodes;
+		// Base Case:
+		if (depth >= search_depth || (specifed_length_on == true && depth >= specified_length)) {
+			if (kStats) ++stats.pruned_depth;
+			return;
+		}
+		// Not Found Case: path is not a prefix of any word
+		uint32_t child = dictionary->child(node, fixed_letters[cell]);
+		if (child == Dictionary::kNoNode) {
+			if (kStats) ++stats.pruned_letter;
+			return;
+		}
+
+		if (kWordHunt) visited |= uint64_t(1) << cell;
+		// Found Case:
+		int32_t word_id = dictionary->word_id(child);
+		if (word_id >= 0 && (specifed_length_on == false || depth + 1 == specified_length)) {
+			if (kStats) ++stats.matches;
+			cell_matches.push_back(make_found_word(word_id, depth + 1, path, original, kWordHunt));
+		}
+		// Recursive Case
+		if (kWordHunt && (geometry.mask[cell] & ~visited) == 0 && !kStats) return;
+		for (int i = 0; i < 8; ++i) {
+			int next = geometry.neighbor[cell][i];
+			if (next < 0) {
+				if (kStats) ++stats.pruned_bounds;
+				continue;
+			}
+			if (kWordHunt) {
+				if (visited >> next & 1) {
+					if (kStats) ++stats.pruned_revisit;
+					continue;
+				}
+			}
+			else if (prev_index >= 0 && i == (prev_index + 4) % 8) continue;
+			fixed_recursive<W, H, kWordHunt, kStats>(child, next, depth + 1, visited, i, path << 3 | i, original, cell_matches, stats);
+		}
+	}
+
+	// EFFECTS: Fills cell_letters, neighbor_cells and neighbor_masks for
+	// the current board
+	void create_bitboard_tables(void) {
+		int cells = width * height;
+		cell_letters.resize(cells);
+		neighbor_cells.resize(cells);
+		neighbor_masks.assign(cells, 0);
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) {
+				int cell = row * width + col;
+				cell_letters[cell] = at(row, col);
+				for (int i = 0; i < 8; ++i) {
+					int r = row + kDirections[i].row;
+					int c = col + kDirections[i].col;
+					if (dimensions_valid(r, c) == false) {
+						neighbor_cells[cell][i] = -1;
+						continue;
+					}
+					neighbor_cells[cell][i] = (int8_t)(r * width + c);
+					neighbor_masks[cell] |= uint64_t(1) << (r * width + c);
+				}
+			}
+		}
+	}
+
+	// EFFECTS: Walks trie and board together from cell, never entering a
+	// cell that is already on the path (bit set in visited). Every match is
+	// Word Hunt valid, so no coordinate sort or check is needed afterwards
+	// Note: path is the packed path so far (see Found_Word)
+	template <bool kStats>
+	void bitboard_recursive(uint32_t node, int cell, int depth, uint64_t visited,
+		uint64_t path, const std::pair<int, int>& original, std::vector<Found_Word>& cell_matches, Search_Stats& stats) {
+		if (kStats) ++stats.nodes;
+		// Base Case:
+		if (depth >= search_depth || (specifed_length_on == true && depth >= specified_length)) {
+			if (kStats) ++stats.pruned_depth;
+			return;
+		}
+		// Not Found Case: path is not a prefix of any word
+		uint32_t child = dictionary->child(node, cell_letters[cell]);
+		if (child == Dictionary::kNoNode) {
+			if (kStats) ++stats.pruned_letter;
+			return;
+		}
+
+		visited |= uint64_t(1) << cell;
+		// Found Case:
+		int32_t word_id = dictionary->word_id(child);
+		if (word_id >= 0 && (specifed_length_on == false || depth + 1 == specified_length)) {
+			if (kStats) ++stats.matches;
+			cell_matches.push_back(make_found_word(word_id, depth + 1, path, original, true));
+		}
+		// Recursive Case: only unvisited neighbors
+		if ((neighbor_masks[cell] & ~visited) == 0 && !kStats) return;
+		for (int i = 0; i < 8; ++i) {
+			int next = neighbor_cells[cell][i];
+			if (next < 0) {
+				if (kStats) ++stats.pruned_bounds;
+				continue;
+			}
+			if (visited >> next & 1) {
+				if (kStats) ++stats.pruned_revisit;
+				continue;
+			}
+			bitboard_recursive<kStats>(child, next, depth + 1, visited, path << 3 | i, original, cell_matches, stats);
+		}
+	}
+
+	// EFFECTS: Walks trie and board together from cell (index into board)
+	// Note: prev_index is the kDirections index of the last step (-1 at
+	// start). The direction straight back to the previous cell is skipped like
+	// in look_recursive. path is the packed path so far (see Found_Word)
+	template <bool kStats>
+	void trie_recursive(uint32_t node, int cell, int depth, int prev_index,
+		uint64_t path, const std::pair<int, int>& original, std::vector<Found_Word>& matches, Search_Stats& stats) {
+		if (kStats) ++stats.nodes;
+		// Base Case:
+		if (depth >= search_depth || (specifed_length_on == true && depth >= specified_length)) {
+			if (kStats) ++stats.pruned_depth;
+			return;
+		}
+		// Not Found Case: path is not a prefix of any word (or cell is the
+		// border)
+		uint32_t child = dictionary->child(node, board[cell]);
+		if (child == Dictionary::kNoNode) {
+			if (kStats) {
+				if (board[cell] == Dictionary::kNoLetter) ++stats.pruned_bounds;
+				else ++stats.pruned_letter;
+			}
+			return;
+		}
+
+		// Found Case:
+		int32_t word_id = dictionary->word_id(child);
+		if (word_id >= 0 && (specifed_length_on == false || depth + 1 == specified_length)) {
+			matches.push_back(make_found_word(word_id, depth + 1, path, original));
+			if (kStats) {
+				++stats.matches;
+				if (word_hunt_mode_on == true && matches.back().word_hunt_valid == false) ++stats.rejected_word_hunt;
+			}
+		}
+		// Recursive Case
+		for (int i = 0; i < 8; ++i) {
+			if (prev_index >= 0 && i == (prev_index + 4) % 8) continue;
+			trie_recursive<kStats>(child, cell + neighbor_offsets[i], depth + 1, i, path << 3 | i, original, matches, stats);
+		}
+	}
+
+	// Iterative Engine Frame
+	// One letter of the current path: the trie node reached, the cell it is
+	// in, the next kDirections index to try from it and the direction taken
+	// into it (-1 at the start cell)
+	struct Dfs_Frame {
+		uint32_t node = 0;
+		int cell = 0;
+		int8_t next = 0;
+		int8_t prev = -1;
+	};
+
+	// EFFECTS: Same search as trie_recursive, but with an explicit stack of
+	// Dfs_Frame instead of the call stack, so a path costs one frame per
+	// letter and never a call. -w and -l are checked while searching: a
+	// Word Hunt path never enters a cell on the path (iterative_on_path), and
+	// a linear path keeps going the way its first step went
+	// NOTES: Directions are tried in kDirections order from every frame, so
+	// matches come out in the same order as trie_recursive. Words are never
+	// longer than Dictionary::kMaxWordLength, which bounds the stack
+	template <bool kStats>
+	void iterative_search(const std::pair<int, int>& original, std::vector<Found_Word>& matches, int worker) {
+		Search_Stats& stats = thread_stats[worker];
+		std::array<Dfs_Frame, Dictionary::kMaxWordLength> stack;
+		int max_depth = std::min(search_depth, Dictionary::kMaxWordLength);
+		if (specifed_length_on == true) max_depth = std::min(max_depth, specified_length);
+		if (kStats) ++stats.nodes;
+		if (max_depth <= 0) {
+			if (kStats) ++stats.pruned_depth;
+			return;
+		}
+		int cell = cell_index(original.first, original.second);
+		uint32_t node = dictionary->child(dictionary->root(), board[cell]);
+		if (node == Dictionary::kNoNode) {
+			if (kStats) ++stats.pruned_letter;
+			return;
+		}
+		// Word Hunt paths are marked in the iterative_on_path of worker,
+		// which every path leaves cleared
+		uint8_t* on_path = word_hunt_mode_on == true ? iterative_on_path[worker].data() : nullptr;
+
+		uint64_t path = 0;
+		int depth = 0;
+		auto push = [&](uint32_t child, int next_cell, int prev) {
+			Dfs_Frame& frame = stack[depth++];
+			frame.node = child;
+			frame.cell = next_cell;
+			frame.next = 0;
+			frame.prev = (int8_t)prev;
+			if (on_path != nullptr) on_path[next_cell] = 1;
+			// Found Case:
+			int32_t word_id = dictionary->word_id(child);
+			if (word_id >= 0 && (specifed_length_on == false || depth == specified_length)) {
+				if (kStats) ++stats.matches;
+				if (on_path != nullptr) matches.push_back(make_found_word(word_id, depth, path, original, true));
+				else matches.push_back(make_found_word(word_id, depth, path, original));
+			}
+			// Base Case: no letter may follow, so no direction is tried
+			if (depth >= max_depth) {
+				if (kStats) ++stats.pruned_depth;
+				frame.next = 8;
+			}
+		};
+		push(node, cell, -1);
+
+		while (depth > 0) {
+			Dfs_Frame& frame = stack[depth - 1];
+			// Every direction tried: step back to the previous letter
+			if (frame.next >= 8) {
+				if (on_path != nullptr) on_path[frame.cell] = 0;
+				if (--depth > 0) path >>= 3;
+				continue;
+			}
+			int i = frame.next++;
+			if (frame.prev >= 0) {
+				if (linear_on == true) {
+					if (i != frame.prev) continue;
+				}
+				else if (i == (frame.prev + 4) % 8) continue;
+			}
+			if (kStats) ++stats.nodes;
+			int next_cell = frame.cell + neighbor_offsets[i];
+			if (on_path != nullptr && on_path[next_cell] != 0) {
+				if (kStats) ++stats.pruned_revisit;
+				continue;
+			}
+			// Not Found Case: path is not a prefix of any word (or cell is
+			// the border)
+			uint32_t child = dictionary->child(frame.node, board[next_cell]);
+			if (child == Dictionary::kNoNode) {
+				if (kStats) {
+					if (board[next_cell] == Dictionary::kNoLetter) ++stats.pruned_bounds;
+					else ++stats.pruned_letter;
+				}
+				continue;
+			}
+			path = path << 3 | i;
+			push(child, next_cell, i);
+		}
+	}
+
+	// EFFECTS: Finds every word that lies on a straight line of board
+	// NOTES: Every row, column and diagonal is read in each of the 8
+	// directions as one line and fed through line_automaton, so the board is
+	// read 8 times in all however long the word list is. A word ending at a
+	// letter is the automaton state there and its output links. Matches are
+	// sorted like in trie_solver, so the order is the same as every other
+	// engine with -l. Straight paths never reuse a cell, so they are all
+	// Word Hunt valid
+	template <bool kStats>
+	void linear_solver(void) {
+		Search_Stats& stats = thread_stats[0];
+		if (line_automaton == nullptr) line_automaton.reset(new Line_Automaton(dictionary));
+		int max_length = std::min(search_depth, Dictionary::kMaxWordLength);
+		matches.clear();
+		for (int i = 0; i < 8; ++i) {
+			int step = neighbor_offsets[i];
+			for (int row = 0; row < height; ++row) {
+				for (int col = 0; col < width; ++col) {
+					// Lines start where the cell before them is the border
+					int first = cell_index(row, col);
+					if (board[first - step] != Dictionary::kNoLetter) continue;
+					uint32_t state = dictionary->root();
+					int position = 0;
+					for (int cell = first; board[cell] != Dictionary::kNoLetter; cell += step, ++position) {
+						if (kStats) ++stats.nodes;
+						state = line_automaton->next(state, board[cell]);
+						uint32_t node = dictionary->word_id(state) >= 0 ? state : line_automaton->next_output(state);
+						for (; node != Dictionary::kNoNode; node = line_automaton->next_output(node)) {
+							uint32_t word_id = (uint32_t)dictionary->word_id(node);
+							int length = (int)dictionary->word(word_id).size();
+							if (length > max_length || (specifed_length_on == true && length != specified_length)) continue;
+							// A one letter word is on a line of every direction,
+							// but is found only once per cell
+							if (length == 1 && i != 0) continue;
+							int start = position - (length - 1);
+							int start_row = row + kDirections[i].row * start;
+							int start_col = col + kDirections[i].col * start;
+							if (specifed_first_letter_on == true) {
+								if ((first_letter_mask >> (at(start_row, start_col) - 'A') & 1) == 0) continue;
+							}
+							uint64_t path = 0;
+							for (int k = 1; k < length; ++k) path = path << 3 | i;
+							if (kStats) ++stats.matches;
+							matches.push_back(make_found_word(word_id, length, path, { start_row, start_col }, true));
+						}
+					}
+				}
+			}
+		}
+		std::sort(matches.begin(), matches.end(), found_word_less);
+		for (const auto& found_word : matches) store_found_word(found_word);
+	}
+
+	// EFFECTS: Adds every match that goes through an edited cell to
+	// cell_matches (see apply_edits)
+	void search_edited(std::vector<Found_Word>& cell_matches) {
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) {
+				int cell = cell_index(row, col);
+				if (edit_distance[cell] > edit_max_length - 1) continue;
+				if (specifed_first_letter_on == true) {
+					if ((first_letter_mask >> (board[cell] - 'A') & 1) == 0) continue;
+				}
+				std::pair<int, int> original(row, col);
+				if (stats_on) edit_recursive<true>(dictionary->root(), cell, 0, -1, 0, false, original, cell_matches, thread_stats[0]);
+				else edit_recursive<false>(dictionary->root(), cell, 0, -1, 0, false, original, cell_matches, thread_stats[0]);
+			}
+		}
+	}
+
+	// EFFECTS: Same search as trie_recursive, but only keeps matches that go
+	// through an edited cell (touched is true once the path has). A path that
+	// has not touched one yet is dropped when the closest edited cell is
+	// further away than the letters it has left
+	template <bool kStats>
+	void edit_recursive(uint32_t node, int cell, int depth, int prev_index, uint64_t path, bool touched,
+		const std::pair<int, int>& original, std::vector<Found_Word>& cell_matches, Search_Stats& stats) {
+		if (kStats) ++stats.nodes;
+		// Base Case:
+		if (depth >= edit_max_length || (touched == false && edit_distance[cell] > edit_max_length - depth - 1)) {
+			if (kStats) ++stats.pruned_depth;
+			return;
+		}
+		// Not Found Case: path is not a prefix of any word (or cell is the
+		// border)
+		uint32_t child = dictionary->child(node, board[cell]);
+		if (child == Dictionary::kNoNode) {
+			if (kStats) {
+				if (board[cell] == Dictionary::kNoLetter) ++stats.pruned_bounds;
+				else ++stats.pruned_letter;
+			}
+			return;
+		}
+		touched = touched || edit_distance[cell] == 0;
+
+		// Found Case:
+		int32_t word_id = dictionary->word_id(child);
+		if (touched && word_id >= 0 && (specifed_length_on == false || depth + 1 == specified_length)) {
+			cell_matches.push_back(make_found_word(word_id, depth + 1, path, original));
+			if (kStats) {
+				++stats.matches;
+				if (word_hunt_mode_on == true && cell_matches.back().word_hunt_valid == false) ++stats.rejected_word_hunt;
+			}
+		}
+		// Recursive Case
+		for (int i = 0; i < 8; ++i) {
+			if (prev_index >= 0 && i == (prev_index + 4) % 8) continue;
+			edit_recursive<kStats>(child, cell + neighbor_offsets[i], depth + 1, i, path << 3 | i, touched, original, cell_matches, stats);
+		}
+	}
+
+	// EFFECTS: Returns true if found_word's path goes through an edited cell
+	bool path_touches_edit(const Found_Word& found_word) const {
+		int cell = cell_index(found_word.row, found_word.col);
+		if (edit_distance[cell] == 0) return true;
+		for (int i = 0; i < found_word.length - 1; ++i) {
+			cell += neighbor_offsets[path_step(found_word, i)];
+			if (edit_distance[cell] == 0) return true;
+		}
+		return false;
+	}
+
+	// EFFECTS: Returns ids of the words edit_cache has a shown path for
+	// (see shown), ascending
+	std::vector<uint32_t> shown_word_ids(void) const {
+		std::vector<uint32_t> ids;
+		for (const auto& found_word : edit_cache) {
+			if (shown(found_word) == false) continue;
+			if (ids.empty() || ids.back() != found_word.word_id) ids.push_back(found_word.word_id);
+		}
+		return ids;
+	}
+
+	// EFFECTS: Given word, finds all occurances of word inside board
+	template <bool kStats>
+	void find_word(std::string_view word, uint32_t word_id, Search_Stats& stats) {
+		// Case 1: word is longer than search_depth (or than a path can hold)
+		if ((int)word.length() > search_depth) return;
+		if (word.length() > Dictionary::kMaxWordLength) return;
+		//bool word_is_apple = word == "APPLE" ? true : false; // for debugging purposes
+		// Case 2: no cell holds the first letter in word
+		if (word[0] < 'A' || word[0] > 'Z') return;
+		// Case 3: look from every cell that does (row major)
+		const uint64_t* starts = &letter_cells[(word[0] - 'A') * cell_words];
+		for (int w = 0; w < cell_words; ++w) {
+			for (uint64_t bits = starts[w]; bits != 0; bits &= bits - 1) {
+				int n = w * 64 + count_trailing_zeros64(bits);
+				look<kStats>(word, word_id, n / width, n % width, stats);
+			}
+		}
+	}
+
+	// EFFECTS: Fills letter_cells for the current board
+	// NOTES: Each letter is compared against 32 (AVX2) or 16 (SSE2) cells at
+	// once, and the compare mask is the next 32 or 16 bits of its bitmap
+	void create_letter_bitmaps(void) {
+		int cells = width * height;
+		cell_words = cells / 64 + 2;
+		letter_cells.assign(26 * cell_words, 0);
+		// Row major letters, padded with 0 (never a letter) to whole blocks
+		cell_letters.assign((cells + 31) / 32 * 32, 0);
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) cell_letters[row * width + col] = at(row, col);
+		}
+		for (int letter = 0; letter < 26; ++letter) {
+			uint64_t* bits = &letter_cells[letter * cell_words];
+			char target = (char)('A' + letter);
+#if defined(__AVX2__)
+			__m256i wanted = _mm256_set1_epi8(target);
+			for (int n = 0; n < cells; n += 32) {
+				__m256i block = _mm256_loadu_si256((const __m256i*)(cell_letters.data() + n));
+				uint32_t hits = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wanted));
+				bits[n >> 6] |= (uint64_t)hits << (n & 63);
+			}
+#elif defined(__SSE2__)
+			__m128i wanted = _mm_set1_epi8(target);
+			for (int n = 0; n < cells; n += 16) {
+				__m128i block = _mm_loadu_si128((const __m128i*)(cell_letters.data() + n));
+				uint32_t hits = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, wanted));
+				bits[n >> 6] |= (uint64_t)hits << (n & 63);
+			}
+#else
+			for (int n = 0; n < cells; ++n) {
+				if (cell_letters[n] == target) bits[n >> 6] |= uint64_t(1) << (n & 63);
+			}
+#endif
+		}
+	}
+
+	// EFFECTS: Returns true if some neighbor of cell (index into board)
+	// holds letter
+	// NOTES: The up to 3 neighbors in one row are next to each other in the
+	// bitmap, so each row is one shift and mask
+	bool neighbors_hold(int cell, char letter) const {
+		if (letter < 'A' || letter > 'Z') return true;
+		const uint64_t* bits = &letter_cells[(letter - 'A') * cell_words];
+		int row = cell / stride - 1;
+		int col = cell % stride - 1;
+		int first = col == 0 ? col : col - 1;
+		int last = col == width - 1 ? col : col + 1;
+		uint64_t span = (uint64_t(1) << (last - first + 1)) - 1;
+		uint64_t center = uint64_t(1) << (col - first);
+		for (int r = std::max(row - 1, 0); r <= std::min(row + 1, height - 1); ++r) {
+			int n = r * width + first;
+			uint64_t window = bits[n >> 6] >> (n & 63);
+			if ((n & 63) > 61) window |= bits[(n >> 6) + 1] << (64 - (n & 63));
+			window &= span;
+			if (r == row) window &= ~center;
+			if (window != 0) return true;
+		}
+		return false;
+	}
+
+	// EFFECTS: Looks in all directions to find word
+	template <bool kStats>
+	void look(std::string_view word, uint32_t word_id, int row, int col, Search_Stats& stats) {
+		int depth = 0;
+		int size_of_word = (int) word.length();
+		std::pair<int, int> original;	// original = original coordinates of word (row,col)
+		original.first = row;
+		original.second = col;
+		look_recursive<kStats>(word, word_id, cell_index(row, col), depth, size_of_word, 'x', 0, original, stats); // x is starting at beginning
+		
+	}
+
+	// EFFECTS: Builds Found_Word for word_id traced from original along path
+	// (packed as described in Found_Word)
+	Found_Word make_found_word(uint32_t word_id, int size_of_word, uint64_t path, const std::pair<int, int>& original) {
+		Found_Word found_word;
+		found_word.word_id = word_id;
+		found_word.row = (uint16_t)original.first;
+		found_word.col = (uint16_t)original.second;
+		found_word.length = (uint8_t)size_of_word;
+		found_word.points = score_table(size_of_word);
+		found_word.path = path;
+		if (word_hunt_mode_on == true) found_word.word_hunt_valid = path_is_word_hunt_valid(found_word);
+		return found_word;
+	}
+
+	// EFFECTS: Same as above, for searches that already know whether the
+	// path is Word Hunt valid (see bitboard_recursive and fixed_recursive)
+	Found_Word make_found_word(uint32_t word_id, int size_of_word, uint64_t path,
+		const std::pair<int, int>& original, bool word_hunt_valid) {
+		Found_Word found_word;
+		found_word.word_id = word_id;
+		found_word.row = (uint16_t)original.first;
+		found_word.col = (uint16_t)original.second;
+		found_word.length = (uint8_t)size_of_word;
+		found_word.points = score_table(size_of_word);
+		found_word.path = path;
+		found_word.word_hunt_valid = word_hunt_valid;
+		return found_word;
+	}
+
+	// EFFECTS: Adds found_word to results
+	// Note: In unique mode only the first path of every word that passes -w
+	// and -l is kept. Both engines store matches by word, then start cell
+	// (row major), then path (directions in kDirections order), so that is the
+	// lowest index path of the word
+	// In top mode only results that pass -w and -l are ranked
+	void store_found_word(const Found_Word& found_word) {
+		if (capture_on) captured.push_back(found_word);
+		if ((unique_on || top_count > 0) && shown(found_word) == false) return;
+		if (unique_on) {
+			if (word_seen[found_word.word_id] == seen_generation) return;
+			word_seen[found_word.word_id] = seen_generation;
+		}
+		if (top_count > 0) {
+			keep_top(found_word);
+			return;
+		}
+		found_words.push_back(found_word);
+	}
+
+	// EFFECTS: Returns true if a ranks before b: more points, then
+	// alphabetically, then found first
+	bool better_result(const Top_Entry& a, const Top_Entry& b) const {
+		if (a.found_word.points != b.found_word.points) return a.found_word.points > b.found_word.points;
+		int order = dictionary->word(a.found_word.word_id).compare(dictionary->word(b.found_word.word_id));
+		if (order != 0) return order < 0;
+		return a.sequence < b.sequence;
+	}
+
+	// EFFECTS: Adds found_word to top_heap if it is one of the best top_count
+	// results so far, dropping the worst one if the heap is full
+	// Time Complexity: O(log top_count)
+	void keep_top(const Found_Word& found_word) {
+		auto worse = [this](const Top_Entry& a, const Top_Entry& b) { return better_result(a, b); };
+		Top_Entry entry = { found_word, top_sequence++ };
+		if (top_heap.size() < top_count) {
+			top_heap.push_back(entry);
+			std::push_heap(top_heap.begin(), top_heap.end(), worse);
+		}
+		else if (better_result(entry, top_heap.front())) {
+			std::pop_heap(top_heap.begin(), top_heap.end(), worse);
+			top_heap.back() = entry;
+			std::push_heap(top_heap.begin(), top_heap.end(), worse);
+		}
+	}
+
+	// EFFECTS: Moves top_heap into found_words, best first
+	void finish_top_results(void) {
+		std::sort(top_heap.begin(), top_heap.end(),
+			[this](const Top_Entry& a, const Top_Entry& b) { return better_result(a, b); });
+		for (const auto& entry : top_heap) found_words.push_back(entry.found_word);
+		top_heap.clear();
+	}
+
+	// EFFECTS: Looks in all directions recursively
+	// Note: cell is index into board. Cells off the board are the border,
+	// which never matches a letter of word
+	template <bool kStats>
+	// Note: prev is the direction taken into cell ('x' at the start) and path
+	// the packed path up to cell (see Found_Word)
+	void look_recursive(std::string_view word, uint32_t word_id, int cell, int depth, 
+		int size_of_word, char prev, uint64_t path, const std::pair<int, int>& original, Search_Stats& stats) {
+
+		if (kStats) ++stats.nodes;
+
+		// Base Case:
+		// depth > search_depth
+		if (depth >= search_depth) {
+			if (kStats) ++stats.pruned_depth;
+			return;
+		}
+		// Not Found Case:
+		if (board[cell] != word[depth]) {
+			if (kStats) {
+				if (board[cell] == Dictionary::kNoLetter) ++stats.pruned_bounds;
+				else ++stats.pruned_letter;
+			}
+			return;
+		}
+		// Found Case:
+		if (board[cell] == word[word.length() - 1] && size_of_word - 1 == depth) {
+			//cout << word << endl;
+			//cout << "found!" << endl;
+
+			// We have original coordinates and directions 
+			// The dirty work is over :)
+			Found_Word found_word = make_found_word(word_id, size_of_word, path, original);
+			if (kStats) {
+				++stats.matches;
+				if (word_hunt_mode_on == true && found_word.word_hunt_valid == false) ++stats.rejected_word_hunt;
+			}
+			store_found_word(found_word);
+			return;
+		}
+		// Not Found Case: no neighbor holds the next letter
+		if (neighbors_hold(cell, word[depth + 1]) == false) {
+			if (kStats) ++stats.pruned_letter;
+			return;
+		}
+
+
+		// Recursive Case
+		// Note: a = NE, b = SE, c = SW, d = NW
+		switch (prev) {
+		case 'x': {
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'n': {
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'a':{
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'e': {
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'b': {
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			break;
+		}
+		case 's':{
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'c': {
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'w':{
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// Southeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[3], depth + 1, size_of_word, 'b', path << 3 | 3, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		case 'd': {
+			// North
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[0], depth + 1, size_of_word, 'n', path << 3 | 0, original, stats);
+			// Northeast
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[1], depth + 1, size_of_word, 'a', path << 3 | 1, original, stats);
+			// East
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[2], depth + 1, size_of_word, 'e', path << 3 | 2, original, stats);
+			// South
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[4], depth + 1, size_of_word, 's', path << 3 | 4, original, stats);
+			// Southwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[5], depth + 1, size_of_word, 'c', path << 3 | 5, original, stats);
+			// West
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[6], depth + 1, size_of_word, 'w', path << 3 | 6, original, stats);
+			// Northwest
+			look_recursive<kStats>(word, word_id, cell + neighbor_offsets[7], depth + 1, size_of_word, 'd', path << 3 | 7, original, stats);
+			break;
+		}
+		default: {
+			assert(false);
+			break;
+		}
+		} // ...switch (prev)
+	}
+
+
+	// EFFECTS: Returns index of (row, col) in board
+	int cell_index(int row, int col) const {
+		return (row + 1) * stride + col + 1;
+	}
+
+	// EFFECTS: Returns letter at (row, col)
+	char at(int row, int col) const {
+		return board[cell_index(row, col)];
+	}
+
+	// EFFECTS: Given row and col returns true if dimensions are valid
+	bool dimensions_valid(int row, int col) {
+		if (row >= 0 && row < height && col >= 0 && col < width) return true;
+		return false;
+	}
+
+	// Largest width and height of any board (Found_Word and the cache keep
+	// rows and cols in 16 bits), and largest board (in cells) read from text
+	static constexpr long long kMaxBoardSide = 0xFFFF;
+	static constexpr long long kMaxBoardCells = 1000000;
+
+	// EFFECTS: Returns true if a board read from text may be w x h
+	static bool board_size_valid(long long w, long long h) {
+		return w > 0 && h > 0 && w <= kMaxBoardSide && h <= kMaxBoardSide && w * h <= kMaxBoardCells;
+	}
+
+
+	// EFFECTS: Sets board to new_board. Returns false (board left empty)
+	// unless new_board has a positive width and height of at most
+	// kMaxBoardSide and exactly width * height letters A-Z (either case)
+	bool set_board(const Board& new_board) {
+		clear_board(0, 0);
+		if (new_board.width <= 0 || new_board.height <= 0) return false;
+		if (new_board.width > kMaxBoardSide || new_board.height > kMaxBoardSide) return false;
+		if ((long long)new_board.width * new_board.height != (long long)new_board.letters.size()) return false;
+		for (char letter : new_board.letters) {
+			if (!std::isalpha((unsigned char)letter)) return false;
+		}
+		clear_board(new_board.width, new_board.height);
+		for (int row = 0; row < height; ++row) {
+			for (int col = 0; col < width; ++col) {
+				board[cell_index(row, col)] = (char)std::toupper((unsigned char)new_board.letters[row * width + col]);
+			}
+		}
+		select_fixed_search();
+		return true;
+	}
+
+	// EFFECTS: Makes board w x h with no letters (border all the way)
+	void clear_board(int w, int h) {
+		width = w;
+		height = h;
+		// assign keeps the buffer's memory from board to board
+		stride = width + 2;
+		board.assign((size_t)(height + 2) * stride, Dictionary::kNoLetter);
+		for (int i = 0; i < 8; ++i) neighbor_offsets[i] = kDirections[i].row * stride + kDirections[i].col;
+		edit_cache_valid = false;
+	}
+	
+};
+
+
+// Solve Params
+// What Solve_Context::solve looks for. Each field works like the command
+// line option named next to it
+struct Solve_Params {
+	enum class Order { k_Found_Order = 0, k_Point_Order, k_Alpha_Order, };
+
+	int search_depth = 6;							// -s
+	bool word_hunt = false;							// -w
+	bool linear = false;							// -l
+	bool unique = false;							// -u
+	int length = 0;									// -x (0 = any length)
+	std::string first_letters;							// -y (empty = any letter)
+	Scoring_Mode scoring = Scoring_Mode::k_Length_Scoring;	// --score
+	size_t top = 0;									// --top (0 = every result)
+	Engine_Mode engine = Engine_Mode::k_Trie_Engine;	// -e
+	Order order = Order::k_Found_Order;				// -p, -a
+	int threads = 1;								// -t
+	size_t cache = 0;								// --cache (0 = no cache, or 1024 boards with cache_file)
+	std::string cache_file;								// --cache-file (turns the cache on)
+	bool edits = false;								// --edit (see Solve_Context::apply_edits)
+
+	bool operator==(const Solve_Params& other) const {
+		return search_depth == other.search_depth && word_hunt == other.word_hunt && linear == other.linear
+			&& unique == other.unique && length == other.length && first_letters == other.first_letters
+			&& scoring == other.scoring && top == other.top && engine == other.engine
+			&& order == other.order && threads == other.threads && cache == other.cache
+			&& cache_file == other.cache_file && edits == other.edits;
+	}
+	bool operator!=(const Solve_Params& other) const { return !(*this == other); }
+};
+
+
+// Solve Context
+// Solves boards in process, for programs that embed the solver instead of
+// running it. The Dictionary is loaded once and shared (it is never changed,
+// so any number of contexts on any number of threads can use it). A context
+// keeps its scratch buffers and results from solve to solve, even when the
+// params change, so it should be reused, one per thread. Nothing is ever
+// printed
+//
+// Example:
+//   auto dictionary = std::make_shared<word_hunt::Dictionary>();
+//   dictionary->load("collins.dict");
+//   word_hunt::Solve_Context context(dictionary);
+//   word_hunt::Solve_Params params;
+//   params.word_hunt = true;
+//   const word_hunt::Solve_Results& results = context.solve({ 4, 4, "ABCDEFGHIJKLMNOP" }, params);
+class Solve_Context {
+public:
+	explicit Solve_Context(std::shared_ptr<const Dictionary> dictionary_in) : dictionary(std::move(dictionary_in)) {}
+
+	// EFFECTS: Solves board and returns its results, which stay valid until
+	// the next solve
+	// Throws Invalid_Board if board is not a valid board (see
+	// Word_Hunt_Core::set_board)
+	const Solve_Results& solve(const Board& board, const Solve_Params& params) {
+		if (solver == nullptr) {
+			solver.reset(new Word_Hunt_Core(options_for(params), dictionary));
+			solver_params = params;
+		}
+		else if (params != solver_params) {
+			solver->configure(options_for(params));
+			solver_params = params;
+		}
+		solver->solve(board, results);
+		return results;
+	}
+
+	// EFFECTS: Changes letters of the board solved last and returns the
+	// results of the edited board, which stay valid until the next solve.
+	// diff gets the words that were added and removed. Only paths through
+	// an edited cell are searched again, so with params.edits on this costs
+	// a fraction of a solve, and edits keep adding up until the next solve
+	// Throws Invalid_Edit if no board has been solved yet, or if an edit is
+	// off the board or not a letter
+	const Solve_Results& apply_edits(const std::vector<Cell_Edit>& edits, Board_Diff& diff) {
+		Invalid_Edit error;
+		if (solver == nullptr) throw error;
+		edit_buffer.clear();
+		for (Cell_Edit edit : edits) {
+			if (std::isalpha((unsigned char)edit.letter) == 0) throw error;
+			edit.letter = (char)std::toupper((unsigned char)edit.letter);
+			edit_buffer.push_back(edit);
+		}
+		diff = solver->solve_edits(edit_buffer, results);
+		return results;
+	}
+
+private:
+	std::shared_ptr<const Dictionary> dictionary;
+	std::unique_ptr<Word_Hunt_Core> solver;		// Reconfigured when the params change
+	Solve_Params solver_params;
+	Solve_Results results;
+	std::vector<Cell_Edit> edit_buffer;
+
+	// EFFECTS: Returns Core_Options that make Word_Hunt_Core solve with params
+	static Core_Options options_for(const Solve_Params& params) {
+		Core_Options options;
+		options.search_depth_output_mode = Search_Depth_Output_Mode::k_Search_Depth_Mode_On;
+		options.search_depth = params.search_depth;
+		if (params.word_hunt) options.word_hunt_mode = Word_Hunt_Mode::k_Word_Hunt_Mode_On;
+		if (params.linear) options.linear_mode = Linear_Search_Only_Mode::k_Linear_Search_Mode_On;
+		if (params.unique) options.unique_mode = Unique_Mode::k_Unique_Mode_On;
+		if (params.length > 0) {
+			options.specify_length_mode = Specify_Length_Mode::k_Specify_Length_Mode_on;
+			options.specified_length = params.length;
+		}
+		if (params.first_letters.empty() == false) {
+			options.specify_first_letter_mode = Specify_First_Letter_Mode::k_Specify_First_Letter_Mode_On;
+			for (char letter : params.first_letters) {
+				if (std::isalpha((unsigned char)letter)) options.specified_first_letters.push_back((char)std::toupper((unsigned char)letter));
+			}
+			std::sort(options.specified_first_letters.begin(), options.specified_first_letters.end());
+		}
+		options.scoring_mode = params.scoring;
+		if (params.top > 0) {
+			options.top_mode = Top_Mode::k_Top_Mode_On;
+			options.top_count = (int)params.top;
+		}
+		options.engine_mode = params.engine;
+		if (params.order == Solve_Params::Order::k_Point_Order) options.point_output_mode = Point_Output_Mode::k_Point_Mode_On;
+		if (params.order == Solve_Params::Order::k_Alpha_Order) options.alpha_output_mode = Alpha_Output_Mode::k_Alpha_Mode_On;
+		options.threads_mode = Threads_Mode::k_Threads_Mode_On;
+		options.thread_count = params.threads;
+		// Like --cache-file, a cache file turns the cache on by itself
+		if (params.cache > 0 || params.cache_file.empty() == false) {
+			options.cache_mode = Cache_Mode::k_Cache_Mode_On;
+			if (params.cache > 0) options.cache_entries = (int)params.cache;
+			options.cache_filename = params.cache_file;
+		}
+		if (params.edits) options.edit_mode = Edit_Mode::k_Edit_Mode_On;
+		return options;
+	}
+};
+
+} // namespace word_hunt
+
+#endif // WORD_HUNT_SOLVER_H
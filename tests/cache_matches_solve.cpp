@@ -0,0 +1,286 @@
+// Checks Board_Cache through Solve_Context. Every board is solved with a
+// cache file, then its 7 other symmetries (turned and mirrored) are solved
+// from the memory tier and, in a new context, from the file tier, and each
+// is compared with a solve without the cache. Then the file is written by
+// another dictionary, which must start it over, and corrupted in several
+// ways, which must drop the bad records instead of crashing or returning
+// their matches.
+//
+// usage: cache_matches_solve DICTIONARY BOARD...
+//
+// Build it from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. -o cache_matches_solve tests/cache_matches_solve.cpp
+
+#include "Word_Hunt_Solver.h"
+#include <iostream>
+#include <random>
+#include <tuple>
+
+using namespace std;
+using namespace word_hunt;
+
+// EFFECTS: Reads board file ("width height" followed by the letters)
+// Throws File_Not_Open if filename can not be read
+Board read_board(const string& filename) {
+	ifstream file(filename);
+	File_Not_Open error1;
+	if (file.is_open() == false) throw error1;
+	Board board;
+	file >> board.width >> board.height;
+	char letter;
+	while (file >> letter) board.letters += letter;
+	return board;
+}
+
+// Setting Struct
+// Params to check. The cache is turned on by the test
+struct Setting {
+	string name;
+	Solve_Params params;
+};
+
+// EFFECTS: Returns setting name with params made by set
+Setting setting_with(const string& name, void (*set)(Solve_Params&)) {
+	Setting setting;
+	setting.name = name;
+	set(setting.params);
+	return setting;
+}
+
+// One result: word id, points and cells (no cells with -u, where any one
+// path of the word may be kept)
+using Result_Key = tuple<uint32_t, uint32_t, vector<uint32_t>>;
+
+// EFFECTS: Returns results as sorted keys, so results that are the same
+// apart from their order compare equal
+vector<Result_Key> result_keys(const Solve_Results& results, bool unique) {
+	vector<Result_Key> keys;
+	for (const auto& result : results.words) {
+		vector<uint32_t> cells;
+		if (unique == false) {
+			cells.assign(results.cells.begin() + result.first_cell, results.cells.begin() + result.first_cell + result.length);
+		}
+		keys.emplace_back(result.word_id, result.points, move(cells));
+	}
+	sort(keys.begin(), keys.end());
+	return keys;
+}
+
+// EFFECTS: Returns board turned by 90 degrees symmetry / 2 times, and
+// mirrored left to right first if symmetry is odd
+Board symmetric_board(const Board& board, int symmetry) {
+	Board moved = board;
+	if (symmetry % 2 == 1) {
+		for (int row = 0; row < board.height; ++row) {
+			for (int col = 0; col < board.width; ++col) {
+				moved.letters[row * board.width + col] = board.letters[row * board.width + board.width - 1 - col];
+			}
+		}
+	}
+	for (int turn = 0; turn < symmetry / 2; ++turn) {
+		Board turned;
+		turned.width = moved.height;
+		turned.height = moved.width;
+		turned.letters.assign(moved.letters.size(), ' ');
+		for (int row = 0; row < moved.height; ++row) {
+			for (int col = 0; col < moved.width; ++col) {
+				turned.letters[col * turned.width + moved.height - 1 - row] = moved.letters[row * moved.width + col];
+			}
+		}
+		moved = turned;
+	}
+	return moved;
+}
+
+// EFFECTS: Returns the whole file (empty if it can not be read)
+string read_bytes(const string& filename) {
+	ifstream file(filename, ios::binary);
+	return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+// EFFECTS: Replaces filename with bytes
+void write_bytes(const string& filename, const string& bytes) {
+	ofstream file(filename, ios::binary | ios::trunc);
+	file.write(bytes.data(), (streamsize)bytes.size());
+}
+
+// EFFECTS: Writes the little endian value of size bytes at at
+void put_bytes(string& bytes, size_t at, uint64_t value, int size) {
+	for (int i = 0; i < size; ++i) bytes[at + i] = (char)(value >> (8 * i) & 0xFF);
+}
+
+// EFFECTS: Removes the cache file and its lock file
+void remove_cache(const string& filename) {
+	remove(filename.c_str());
+	remove((filename + ".lock").c_str());
+}
+
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		cerr << "usage: " << argv[0] << " DICTIONARY BOARD..." << endl;
+		return 2;
+	}
+	auto dictionary = make_shared<Dictionary>();
+	dictionary->load(argv[1]);
+	vector<Board> boards;
+	for (int i = 2; i < argc; ++i) boards.push_back(read_board(argv[i]));
+	string cache_file = "cache_matches_solve." + to_string((unsigned long)getpid()) + ".cache";
+
+	vector<Setting> settings = {
+		setting_with("-w", [](Solve_Params& p) { p.word_hunt = true; }),
+		setting_with("-p -u -w", [](Solve_Params& p) { p.word_hunt = true; p.unique = true; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-l", [](Solve_Params& p) { p.linear = true; }),
+		setting_with("-x 5 -y AEST", [](Solve_Params& p) { p.length = 5; p.first_letters = "AEST"; }),
+		setting_with("-e scan -w", [](Solve_Params& p) { p.engine = Engine_Mode::k_Scan_Engine; p.word_hunt = true; }),
+		setting_with("-t 3 -w", [](Solve_Params& p) { p.threads = 3; p.word_hunt = true; }),
+	};
+
+	int failed = 0;
+	// EFFECTS: Reports a failure unless results match expected
+	auto check = [&](const string& what, const Solve_Results& results, const Solve_Results& expected, bool unique) {
+		if (result_keys(results, unique) != result_keys(expected, unique)) {
+			cout << "FAIL: " << what << "\n";
+			failed = 1;
+		}
+	};
+
+	// Symmetries from the memory tier and the file tier. Solving a board the
+	// cache has leaves the file as it is, so an unchanged file shows that
+	// every symmetry was answered from the cache
+	for (const auto& setting : settings) {
+		Solve_Params cached_params = setting.params;
+		cached_params.cache_file = cache_file;
+		bool unique = setting.params.unique;
+		Solve_Context uncached(dictionary);
+		for (size_t i = 0; i < boards.size(); ++i) {
+			string name = setting.name + " " + argv[i + 2];
+			vector<Solve_Results> expected;
+			for (int symmetry = 0; symmetry < 8; ++symmetry) {
+				expected.push_back(uncached.solve(symmetric_board(boards[i], symmetry), setting.params));
+			}
+			remove_cache(cache_file);
+			string file_bytes;
+			{
+				Solve_Context memory(dictionary);
+				check(name + " solve", memory.solve(boards[i], cached_params), expected[0], unique);
+				file_bytes = read_bytes(cache_file);
+				for (int symmetry = 1; symmetry < 8; ++symmetry) {
+					check(name + " symmetry " + to_string(symmetry) + " from memory",
+						memory.solve(symmetric_board(boards[i], symmetry), cached_params), expected[symmetry], unique);
+				}
+			}
+			{
+				Solve_Context file(dictionary);
+				for (int symmetry = 1; symmetry < 8; ++symmetry) {
+					check(name + " symmetry " + to_string(symmetry) + " from file",
+						file.solve(symmetric_board(boards[i], symmetry), cached_params), expected[symmetry], unique);
+				}
+			}
+			if (read_bytes(cache_file) != file_bytes) {
+				cout << "FAIL: " << name << " symmetries were not answered from the cache\n";
+				failed = 1;
+			}
+		}
+	}
+
+	Solve_Params params;
+	params.word_hunt = true;
+	Solve_Params cached_params = params;
+	cached_params.cache_file = cache_file;
+	Solve_Context uncached(dictionary);
+	Solve_Results expected = uncached.solve(boards[0], params);
+
+	// A dictionary without the first word found on the board has another
+	// hash, so the file it finds must be started over instead of answering
+	// with the removed word
+	{
+		string word_list = cache_file + ".words";
+		{
+			ofstream file(word_list);
+			for (uint32_t id = 0; id < dictionary->size(); ++id) {
+				if (id != expected.words[0].word_id) file << dictionary->word(id) << "\n";
+			}
+		}
+		auto other_dictionary = make_shared<Dictionary>();
+		other_dictionary->load(word_list);
+		remove(word_list.c_str());
+		remove_cache(cache_file);
+		{
+			Solve_Context context(dictionary);
+			context.solve(boards[0], cached_params);
+		}
+		Solve_Context other_uncached(other_dictionary);
+		Solve_Results other_expected = other_uncached.solve(boards[0], params);
+		Solve_Context other(other_dictionary);
+		check("other dictionary", other.solve(boards[0], cached_params), other_expected, false);
+		for (const auto& result : other.solve(boards[0], cached_params).words) {
+			if (result.word == expected.words[0].word) {
+				cout << "FAIL: other dictionary found the removed word " << result.word << "\n";
+				failed = 1;
+			}
+		}
+	}
+
+	// Corrupted files. The record of boards[0] starts after the header
+	// ("WHCACHE\0", version, signature size, signature), its first match
+	// after rows, cols, count and the letters
+	remove_cache(cache_file);
+	{
+		Solve_Context context(dictionary);
+		context.solve(boards[0], cached_params);
+		context.solve(boards[1 % boards.size()], cached_params);
+	}
+	string good = read_bytes(cache_file);
+	size_t record = 16 + (uint8_t)good[12] + ((uint8_t)good[13] << 8);
+	size_t first_match = record + 8 + boards[0].letters.size();
+	size_t record_size = first_match - record + 18 * (size_t)expected.words.size();
+	struct Corruption {
+		string name;
+		size_t at;
+		uint64_t value;
+		int size;
+	};
+	vector<Corruption> corruptions = {
+		{ "word id past the dictionary", first_match, 0xFFFFFFF0u, 4 },
+		{ "row off the board", first_match + 4, 0xFFFF, 2 },
+		{ "col off the board", first_match + 6, (uint64_t)boards[0].width, 2 },
+		{ "length 0", first_match + 8, 0, 1 },
+		{ "length past the longest word", first_match + 8, 200, 1 },
+		{ "path off the board", first_match + 10, 0xFFFFFFFFFFFFFFFFull, 8 },
+		{ "no rows", record, 0, 2 },
+		{ "more matches than the record has", record + 4, 0x7FFFFFFF, 4 },
+		{ "letter that is not A-Z", record + 8, '!', 1 },
+	};
+	for (const auto& corruption : corruptions) {
+		string bytes = good;
+		put_bytes(bytes, corruption.at, corruption.value, corruption.size);
+		write_bytes(cache_file, bytes);
+		Solve_Context context(dictionary);
+		check("corrupted file, " + corruption.name, context.solve(boards[0], cached_params), expected, false);
+	}
+	// A random byte can also turn a match into another one that could be on
+	// the board, so these only have to load without crashing
+	mt19937 random(1);
+	for (int i = 0; i < 200; ++i) {
+		string bytes = good;
+		bytes[record + random() % record_size] = (char)(random() & 0xFF);
+		write_bytes(cache_file, bytes);
+		Solve_Context context(dictionary);
+		context.solve(boards[0], cached_params);
+	}
+	// A short append (the end of a record missing) followed by a whole
+	// record from another solver
+	{
+		string bytes = good.substr(0, record + record_size);
+		bytes += good.substr(record, record_size / 2);
+		bytes += good.substr(record);
+		write_bytes(cache_file, bytes);
+		Solve_Context context(dictionary);
+		check("short append", context.solve(boards[0], cached_params), expected, false);
+	}
+	remove_cache(cache_file);
+
+	if (failed == 0) cout << "Cache matches solves\n";
+	return failed;
+}
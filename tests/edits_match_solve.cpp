@@ -0,0 +1,189 @@
+// Checks that Solve_Context::apply_edits gives the same results as solving
+// the edited board from scratch. Every board gets random one cell edits,
+// each applied to a fresh solve of the board, and then a chain of random
+// edits (one to three cells at a time) that keep adding up. After every
+// edit the results and the added and removed words are compared with a
+// fresh solve of the edited board by the trie engine on one thread, with
+// each engine and -t 1 and -t 3 in turn.
+//
+// usage: edits_match_solve DICTIONARY BOARD...
+//
+// Build it from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. -o edits_match_solve tests/edits_match_solve.cpp
+
+#include "Word_Hunt_Solver.h"
+#include <iostream>
+#include <random>
+#include <tuple>
+
+using namespace std;
+using namespace word_hunt;
+
+// EFFECTS: Reads board file ("width height" followed by the letters)
+// Throws File_Not_Open if filename can not be read
+Board read_board(const string& filename) {
+	ifstream file(filename);
+	File_Not_Open error1;
+	if (file.is_open() == false) throw error1;
+	Board board;
+	file >> board.width >> board.height;
+	char letter;
+	while (file >> letter) board.letters += letter;
+	return board;
+}
+
+// Setting Struct
+// Params to check. The fresh solves use the same params with the trie
+// engine on one thread
+struct Setting {
+	string name;
+	Solve_Params params;
+};
+
+// EFFECTS: Returns setting name with params made by set
+Setting setting_with(const string& name, void (*set)(Solve_Params&)) {
+	Setting setting;
+	setting.name = name;
+	set(setting.params);
+	return setting;
+}
+
+// One result: word id, points and cells (no cells with -u, where any one
+// path of the word may be kept)
+using Result_Key = tuple<uint32_t, uint32_t, vector<uint32_t>>;
+
+// EFFECTS: Returns results as sorted keys, so results that are the same
+// apart from their order compare equal
+vector<Result_Key> result_keys(const Solve_Results& results, bool unique) {
+	vector<Result_Key> keys;
+	for (const auto& result : results.words) {
+		vector<uint32_t> cells;
+		if (unique == false) {
+			cells.assign(results.cells.begin() + result.first_cell, results.cells.begin() + result.first_cell + result.length);
+		}
+		keys.emplace_back(result.word_id, result.points, move(cells));
+	}
+	sort(keys.begin(), keys.end());
+	return keys;
+}
+
+// EFFECTS: Returns the ids of the words in results, ascending and once each
+vector<uint32_t> word_ids(const Solve_Results& results) {
+	vector<uint32_t> ids;
+	for (const auto& result : results.words) ids.push_back(result.word_id);
+	sort(ids.begin(), ids.end());
+	ids.erase(unique(ids.begin(), ids.end()), ids.end());
+	return ids;
+}
+
+// EFFECTS: Returns diff expected between the words of before and after
+Board_Diff expected_diff(const vector<uint32_t>& before, const vector<uint32_t>& after) {
+	Board_Diff diff;
+	set_difference(after.begin(), after.end(), before.begin(), before.end(), back_inserter(diff.added));
+	set_difference(before.begin(), before.end(), after.begin(), after.end(), back_inserter(diff.removed));
+	return diff;
+}
+
+// EFFECTS: Returns edits random cells of board to random letters
+vector<Cell_Edit> random_edits(const Board& board, int edits, mt19937& random) {
+	vector<Cell_Edit> cell_edits;
+	for (int i = 0; i < edits; ++i) {
+		Cell_Edit edit;
+		edit.row = (int)(random() % board.height);
+		edit.col = (int)(random() % board.width);
+		edit.letter = (char)('A' + random() % 26);
+		cell_edits.push_back(edit);
+	}
+	return cell_edits;
+}
+
+// EFFECTS: Returns board with cell_edits written to it
+Board edited_board(Board board, const vector<Cell_Edit>& cell_edits) {
+	for (const auto& edit : cell_edits) board.letters[edit.row * board.width + edit.col] = edit.letter;
+	return board;
+}
+
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		cerr << "usage: " << argv[0] << " DICTIONARY BOARD..." << endl;
+		return 2;
+	}
+	auto dictionary = make_shared<Dictionary>();
+	dictionary->load(argv[1]);
+	vector<Board> boards;
+	for (int i = 2; i < argc; ++i) boards.push_back(read_board(argv[i]));
+
+	const int kSingleEdits = 20;
+	const int kChainedEdits = 20;
+	vector<Setting> engine_settings = {
+		setting_with("-e trie", [](Solve_Params&) {}),
+		setting_with("-e trie -w", [](Solve_Params& p) { p.word_hunt = true; }),
+		setting_with("-e trie -u -w", [](Solve_Params& p) { p.word_hunt = true; p.unique = true; }),
+		setting_with("-e trie -x 5 -y AEST", [](Solve_Params& p) { p.length = 5; p.first_letters = "AEST"; }),
+		setting_with("-e scan -w", [](Solve_Params& p) { p.engine = Engine_Mode::k_Scan_Engine; p.word_hunt = true; }),
+		setting_with("-e iterative -w", [](Solve_Params& p) { p.engine = Engine_Mode::k_Iterative_Engine; p.word_hunt = true; }),
+		setting_with("-e linear -l", [](Solve_Params& p) { p.engine = Engine_Mode::k_Linear_Engine; p.linear = true; }),
+	};
+	vector<Setting> settings;
+	for (int threads : { 1, 3 }) {
+		for (Setting setting : engine_settings) {
+			setting.name += " -t " + to_string(threads) + " --edit";
+			setting.params.threads = threads;
+			setting.params.edits = true;
+			settings.push_back(setting);
+		}
+	}
+	// The last setting checks edits after a solve that did not keep its
+	// matches (apply_edits then searches the whole board once)
+	settings.push_back(setting_with("-e trie -w (no --edit)", [](Solve_Params& p) { p.word_hunt = true; }));
+
+	int failed = 0;
+	for (const auto& setting : settings) {
+		Solve_Params fresh_params = setting.params;
+		fresh_params.engine = Engine_Mode::k_Trie_Engine;
+		fresh_params.threads = 1;
+		fresh_params.edits = false;
+		bool unique = setting.params.unique;
+		Solve_Context context(dictionary);
+		Solve_Context fresh(dictionary);
+		mt19937 random(1);
+
+		// EFFECTS: Compares results and diff of the edits that turned before
+		// into after with a fresh solve of after
+		auto check = [&](const string& what, const Board& before, const Board& after,
+				const Solve_Results& results, const Board_Diff& diff) {
+			vector<uint32_t> before_ids = word_ids(fresh.solve(before, fresh_params));
+			const Solve_Results& expected = fresh.solve(after, fresh_params);
+			Board_Diff expected_words = expected_diff(before_ids, word_ids(expected));
+			if (result_keys(results, unique) != result_keys(expected, unique)
+				|| diff.added != expected_words.added || diff.removed != expected_words.removed) {
+				cout << "FAIL: " << setting.name << " " << what << ": " << after.letters << "\n";
+				failed = 1;
+			}
+		};
+
+		for (size_t i = 0; i < boards.size(); ++i) {
+			string board_name = argv[i + 2];
+			for (int edit = 0; edit < kSingleEdits; ++edit) {
+				vector<Cell_Edit> cell_edits = random_edits(boards[i], 1, random);
+				context.solve(boards[i], setting.params);
+				Board_Diff diff;
+				const Solve_Results& results = context.apply_edits(cell_edits, diff);
+				check(board_name + " edit " + to_string(edit), boards[i], edited_board(boards[i], cell_edits), results, diff);
+			}
+			Board board = boards[i];
+			context.solve(board, setting.params);
+			for (int edit = 0; edit < kChainedEdits; ++edit) {
+				vector<Cell_Edit> cell_edits = random_edits(board, 1 + (int)(random() % 3), random);
+				Board_Diff diff;
+				const Solve_Results& results = context.apply_edits(cell_edits, diff);
+				Board after = edited_board(board, cell_edits);
+				check(board_name + " chained edit " + to_string(edit), board, after, results, diff);
+				board = after;
+			}
+		}
+	}
+	if (failed == 0) cout << "Edits match fresh solves\n";
+	return failed;
+}
@@ -0,0 +1,50 @@
+#!/bin/sh
+# Checks that every search engine prints the same bytes as the trie engine
+# for the boards in tests/boards, with the options that hide found words
+# (-w, -l) and so decide which --Length-- headers -p prints.
+#
+# usage: tests/engines_match.sh SOLVER [DICTIONARY]
+#
+# SOLVER is the compiled Word_Hunt_Solver and DICTIONARY is the word list
+# (defaults to the one in the repository). Pass a dictionary compiled with
+# --compile-dictionary to make the run faster.
+
+solver=$1
+dir=$(dirname "$0")
+dictionary=${2:-$dir/../Collins_Scrabble_Words_(2019).txt}
+if [ -z "$solver" ]; then
+	echo "usage: $0 SOLVER [DICTIONARY]" >&2
+	exit 2
+fi
+
+engines="scan iterative linear"
+options="-p|-p -w|-c -p -w|-i -p -w|-p -u -w|-a -w|-c -w|-p -l|-c -p -l|-c -p -w -l|-a -l -i"
+
+expected=$(mktemp)
+actual=$(mktemp)
+trap 'rm -f "$expected" "$actual"' EXIT
+failed=0
+IFS='|'
+for board in "$dir"/boards/*.txt; do
+	for option in $options; do
+		unset IFS
+		"$solver" -d "$dictionary" -e trie $option -b "$board" > "$expected" 2>&1
+		for engine in $engines; do
+			# The linear engine turns on -l by itself
+			case "$engine $option" in
+				"linear "*-l*) ;;
+				linear*) continue ;;
+			esac
+			"$solver" -d "$dictionary" -e $engine $option -b "$board" > "$actual" 2>&1
+			if ! cmp -s "$expected" "$actual"; then
+				echo "FAIL: -e $engine $option -b $board"
+				failed=1
+			fi
+		done
+		IFS='|'
+	done
+done
+unset IFS
+
+if [ $failed = 0 ]; then echo "All engines match"; fi
+exit $failed
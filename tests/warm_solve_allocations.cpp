@@ -0,0 +1,93 @@
+// Checks that solving a board again makes no heap allocation: a
+// Solve_Context grows its buffers on the first solve and reuses them from
+// then on. Every board is solved to warm the context up and then again
+// while counting calls to operator new, with each setting below.
+//
+// usage: warm_solve_allocations DICTIONARY BOARD...
+//
+// Build it from the repository root:
+//   g++ -std=c++17 -O2 -pthread -I. -o warm_solve_allocations tests/warm_solve_allocations.cpp
+
+#include "Word_Hunt_Solver.h"
+#include "Allocation_Counter.h"
+#include <iostream>
+
+using namespace std;
+using namespace word_hunt;
+
+// EFFECTS: Reads board file ("width height" followed by the letters)
+// Throws File_Not_Open if filename can not be read
+Board read_board(const string& filename) {
+	ifstream file(filename);
+	File_Not_Open error1;
+	if (file.is_open() == false) throw error1;
+	Board board;
+	file >> board.width >> board.height;
+	char letter;
+	while (file >> letter) board.letters += letter;
+	return board;
+}
+
+// Setting Struct
+// Params to check, and how many solves of a board warm the context up
+struct Setting {
+	string name;
+	Solve_Params params;
+	int warm_solves = 1;
+};
+
+// EFFECTS: Returns setting name with params made by set
+Setting setting_with(const string& name, void (*set)(Solve_Params&), int warm_solves = 1) {
+	Setting setting;
+	setting.name = name;
+	set(setting.params);
+	setting.warm_solves = warm_solves;
+	return setting;
+}
+
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		cerr << "usage: " << argv[0] << " DICTIONARY BOARD..." << endl;
+		return 2;
+	}
+	auto dictionary = make_shared<Dictionary>();
+	dictionary->load(argv[1]);
+	vector<Board> boards;
+	for (int i = 2; i < argc; ++i) boards.push_back(read_board(argv[i]));
+
+	// With --cache the first solve of a board stores it and the second is
+	// the first one answered from the cache
+	vector<Setting> settings = {
+		setting_with("-e trie", [](Solve_Params&) {}),
+		setting_with("-p -w", [](Solve_Params& p) { p.word_hunt = true; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-a -u -w", [](Solve_Params& p) { p.word_hunt = true; p.unique = true; p.order = Solve_Params::Order::k_Alpha_Order; }),
+		setting_with("-p -l", [](Solve_Params& p) { p.linear = true; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-x 5 -y AB -p", [](Solve_Params& p) { p.length = 5; p.first_letters = "AB"; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("--score word-hunt --top 10 -w", [](Solve_Params& p) { p.word_hunt = true; p.scoring = Scoring_Mode::k_Word_Hunt_Scoring; p.top = 10; }),
+		setting_with("-e scan -p", [](Solve_Params& p) { p.engine = Engine_Mode::k_Scan_Engine; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-e iterative -p -w", [](Solve_Params& p) { p.engine = Engine_Mode::k_Iterative_Engine; p.word_hunt = true; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-e linear -p", [](Solve_Params& p) { p.engine = Engine_Mode::k_Linear_Engine; p.linear = true; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-t 4 -p -w", [](Solve_Params& p) { p.threads = 4; p.word_hunt = true; p.order = Solve_Params::Order::k_Point_Order; }),
+		setting_with("-e iterative -t 4 -w", [](Solve_Params& p) { p.engine = Engine_Mode::k_Iterative_Engine; p.threads = 4; p.word_hunt = true; }),
+		setting_with("--cache 16 -p -w", [](Solve_Params& p) { p.cache = 16; p.word_hunt = true; p.order = Solve_Params::Order::k_Point_Order; }, 2),
+		setting_with("--edit -p -w", [](Solve_Params& p) { p.edits = true; p.word_hunt = true; p.order = Solve_Params::Order::k_Point_Order; }),
+	};
+
+	int failed = 0;
+	for (const auto& setting : settings) {
+		Solve_Context context(dictionary);
+		for (size_t i = 0; i < boards.size(); ++i) {
+			for (int warm = 0; warm < setting.warm_solves; ++warm) context.solve(boards[i], setting.params);
+			uint64_t before = g_allocation_count.load(memory_order_relaxed);
+			context.solve(boards[i], setting.params);
+			uint64_t allocations = g_allocation_count.load(memory_order_relaxed) - before;
+			if (allocations != 0) {
+				cout << "FAIL: " << setting.name << " " << argv[i + 2] << ": " << allocations << " allocations\n";
+				failed = 1;
+			}
+		}
+	}
+	if (failed == 0) cout << "No allocations in warm solves\n";
+	return failed;
+}